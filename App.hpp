@@ -0,0 +1,58 @@
+#ifndef APP_HPP
+#define APP_HPP
+
+#include "Elements.hpp"
+#include "UpdateQueue.hpp"
+#ifdef __cpp_impl_coroutine
+#include "Tasks.hpp"
+#endif
+
+// --- The demo layout, shared by main.cpp and the replay and serve tools ---
+// buildApp() keeps no state in the tree, so SessionServer can build one per terminal size.
+
+Column* drawColumn(std::initializer_list<Element*> list = {}) {
+    return new Column(0, 0, list);
+}
+
+Row* drawRow(std::initializer_list<Element*> list = {}) {
+    return new Row(0, 0, list);
+}
+
+Canvas* drawCanvas(std::initializer_list<Element*> list = {}) {
+    return new Canvas(0, 0, list);
+}
+
+Terminal* buildApp(Screen* screen) {
+    return new Terminal(screen, {
+        drawColumn({
+            drawColumn({
+                drawCanvas()->size(10, 5),
+                drawCanvas()->size(10, 5),
+                drawRow()->fillMaxWidth()->height(5)
+            })->fillMaxSize()
+        })->fillMaxSize()
+    });
+}
+
+// Runs updates posted from other threads and, in C++20 builds, resumes Tasks that are due.
+// Called once per frame before layout, by main.cpp and when replaying a recording.
+void appTick() {
+#ifdef __cpp_impl_coroutine
+    uiScheduler().tick();
+#else
+    uiUpdates().drain();
+#endif
+}
+
+// Handles a chunk of raw input, live or recorded. Returns false once the app should quit.
+bool appInput(const char* buf, int n) {
+#ifdef __cpp_impl_coroutine
+    uiScheduler().feedInput(buf, n);
+#endif
+    for (int i = 0; i < n; i++) {
+        if (buf[i] == 'q') return false; // Quit on 'q'
+    }
+    return true;
+}
+
+#endif
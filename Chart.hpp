@@ -0,0 +1,264 @@
+#ifndef CHART_HPP
+#define CHART_HPP
+
+#include "Elements.hpp"
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <memory>
+
+// --- Single-producer / single-consumer sample ring ---
+// The producer thread calls push(), the UI thread calls pop(); neither ever blocks.
+// When the UI falls behind by more than Capacity samples, new samples are dropped.
+template <typename T, size_t Capacity>
+struct SampleRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    T m_slots[Capacity];
+    alignas(64) std::atomic<size_t> m_head{0}; // next slot the producer writes
+    alignas(64) std::atomic<size_t> m_tail{0}; // next slot the consumer reads
+
+    bool push(const T& value) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity) return false; // full
+        m_slots[head & (Capacity - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Moves up to `max` samples into `out`, returns how many
+    size_t pop(T* out, size_t max) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t available = m_head.load(std::memory_order_acquire) - tail;
+        size_t count = std::min(available, max);
+        for (size_t i = 0; i < count; i++) {
+            out[i] = m_slots[(tail + i) & (Capacity - 1)];
+        }
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+};
+
+// --- Samples behind one or more Charts ---
+// Each series gets a lock-free ring that one producer thread may push() into at any
+// rate. On the UI thread, update() drains only the samples that arrived since the
+// last frame and folds them into min/max buckets, so the cost per frame follows the
+// sample rate, not the history kept. The data lives outside the element tree: several
+// Charts can share it, e.g. one per terminal size under SessionServer.
+//
+// The data holds the last `window` samples, or everything since the start when the
+// window is 0. Buckets are sized for the widest chart drawn so far: a bucket holds
+// window / columns samples, and without a window adjacent buckets are merged pairwise
+// once they no longer fit. Merging is exact (min of the mins, max of the maxes), so
+// narrower charts combine buckets per column and no spike is ever lost.
+struct ChartData {
+    static const size_t RING_CAPACITY = 1 << 16;
+
+    struct Bucket {
+        float min = std::numeric_limits<float>::infinity();
+        float max = -std::numeric_limits<float>::infinity();
+        size_t count = 0;
+
+        void add(float v) {
+            min = std::min(min, v);
+            max = std::max(max, v);
+            count++;
+        }
+
+        void merge(const Bucket& other) {
+            min = std::min(min, other.min);
+            max = std::max(max, other.max);
+            count += other.count;
+        }
+    };
+
+    struct Series {
+        std::unique_ptr<SampleRing<float, RING_CAPACITY>> ring = std::make_unique<SampleRing<float, RING_CAPACITY>>();
+        std::deque<Bucket> buckets; // completed buckets, oldest first
+        Bucket partial;             // bucket still being filled
+        size_t bucketSize = 1;      // samples per completed bucket
+        size_t samples = 0;         // samples held in buckets and partial
+    };
+
+    std::vector<Series> m_series;
+    size_t m_window;      // samples kept, 0 = all of them
+    size_t m_columns = 0; // pixel columns of the widest chart drawn so far
+
+    explicit ChartData(size_t window = 0): m_window(window) {}
+
+    ChartData(const ChartData&) = delete;
+    ChartData& operator=(const ChartData&) = delete;
+
+    // Adds a series and returns its index; call before producers start
+    size_t addSeries() {
+        m_series.emplace_back();
+        m_series.back().bucketSize = windowBucketSize();
+        return m_series.size() - 1;
+    }
+
+    // Thread-safe for one producer per series. Returns false if the sample was dropped.
+    bool push(size_t series, float value) {
+        return m_series[series].ring->push(value);
+    }
+
+    // UI thread, from each Chart's drawGraphics(): widens the buckets' target to
+    // `columns` if needed and folds in the new samples. Later calls in the same
+    // frame find nothing new to drain.
+    void update(size_t columns) {
+        if (columns > m_columns) {
+            m_columns = columns;
+            if (m_window) {
+                for (Series& s : m_series) s.bucketSize = windowBucketSize();
+            }
+        }
+        for (Series& s : m_series) consume(s);
+    }
+
+private:
+    size_t windowBucketSize() const {
+        if (!m_window || !m_columns) return 1;
+        return std::max<size_t>((m_window + m_columns - 1) / m_columns, 1);
+    }
+
+    static void mergePairs(std::deque<Bucket>& buckets) {
+        size_t kept = 0;
+        for (size_t i = 0; i < buckets.size(); i += 2) {
+            Bucket merged = buckets[i];
+            if (i + 1 < buckets.size()) merged.merge(buckets[i + 1]);
+            buckets[kept++] = merged;
+        }
+        buckets.resize(kept);
+    }
+
+    void consume(Series& s) {
+        float batch[1024];
+        size_t n;
+        while ((n = s.ring->pop(batch, 1024)) > 0) {
+            for (size_t i = 0; i < n; i++) {
+                if (std::isnan(batch[i])) continue;
+                s.partial.add(batch[i]);
+                s.samples++;
+                if (s.partial.count >= s.bucketSize) {
+                    s.buckets.push_back(s.partial);
+                    s.partial = Bucket();
+                }
+            }
+        }
+
+        // Keep one column free for the partial bucket
+        size_t fit = std::max<size_t>(m_columns, 2) - 1;
+
+        // Buckets older than the window are no longer shown; a full-size bucket that no
+        // longer fits only holds the rounding remainder of the window
+        if (m_window) {
+            while (!s.buckets.empty() && (s.samples - s.buckets.front().count >= m_window ||
+                                          (s.buckets.size() > fit && s.buckets.front().count >= s.bucketSize))) {
+                s.samples -= s.buckets.front().count;
+                s.buckets.pop_front();
+            }
+        }
+
+        // Whole history: halve the resolution whenever it outgrows the columns
+        while (s.buckets.size() > fit) {
+            mergePairs(s.buckets);
+            if (!m_window) s.bucketSize *= 2;
+        }
+    }
+};
+
+// --- Streaming time-series chart ---
+// A braille Canvas plotting a ChartData, one min/max line per pixel column. A Chart
+// made with a window (or none) owns its data; pass a shared ChartData instead to show
+// the same series in several trees.
+struct Chart : public Canvas {
+    using Bucket = ChartData::Bucket;
+
+    std::shared_ptr<ChartData> m_data;
+    bool m_autoRange = true;
+    float m_rangeMin = 0, m_rangeMax = 1;
+
+    Chart(size_t w = 0, size_t h = 0, size_t window = 0): Chart(std::make_shared<ChartData>(window), w, h) {}
+
+    Chart(std::shared_ptr<ChartData> data, size_t w = 0, size_t h = 0): Canvas(w, h), m_data(std::move(data)) {
+        m_title = "Chart";
+        pixelMode(PixelMode::BRAILLE);
+    }
+
+    ChartData& data() { return *m_data; }
+
+    size_t addSeries() { return m_data->addSeries(); }
+
+    // Thread-safe for one producer per series. Returns false if the sample was dropped.
+    bool push(size_t series, float value) { return m_data->push(series, value); }
+
+    // Fixes the vertical axis instead of fitting it to the visible samples
+    Chart* range(float min, float max) {
+        m_autoRange = false;
+        m_rangeMin = min;
+        m_rangeMax = max;
+        return this;
+    }
+
+    void drawGraphics() override {
+        fitBitmap();
+        size_t columns = m_bitmap.pixelWidth();
+        if (columns > 0) m_data->update(columns);
+
+        m_bitmap.clear();
+        if (columns > 0 && m_bitmap.pixelHeight() > 0) plot(columns);
+        Canvas::drawGraphics();
+    }
+
+private:
+    void plot(size_t columns) {
+        const std::vector<ChartData::Series>& series = m_data->m_series;
+
+        float lo = m_rangeMin, hi = m_rangeMax;
+        if (m_autoRange) {
+            lo = std::numeric_limits<float>::infinity();
+            hi = -std::numeric_limits<float>::infinity();
+            for (const ChartData::Series& s : series) {
+                for (const Bucket& b : s.buckets) { lo = std::min(lo, b.min); hi = std::max(hi, b.max); }
+                if (s.partial.count) { lo = std::min(lo, s.partial.min); hi = std::max(hi, s.partial.max); }
+            }
+            if (!(lo <= hi)) return; // no samples yet
+        }
+        if (hi - lo < 1e-12f) { lo -= 0.5f; hi += 0.5f; }
+
+        long height = (long)m_bitmap.pixelHeight();
+        float scale = (height - 1) / (hi - lo);
+        auto toY = [&](float v) {
+            long y = (height - 1) - std::lround((v - lo) * scale);
+            return std::min(std::max(y, 0L), height - 1);
+        };
+
+        std::vector<Bucket> shown(columns);
+        for (const ChartData::Series& s : series) {
+            // Samples per column: one bucket on the widest chart, more on narrower ones, where
+            // a bucket on a column boundary is merged into both columns
+            size_t span = m_data->m_window ? m_data->m_window : (s.buckets.size() + 1) * s.bucketSize;
+            size_t perColumn = std::max(s.bucketSize, (span + columns - 1) / columns);
+
+            // Right-align the newest sample; the partial bucket counts as a full one
+            std::fill(shown.begin(), shown.end(), Bucket());
+            size_t used = 0;
+            if (s.partial.count) {
+                shown[columns - 1] = s.partial;
+                used = s.bucketSize;
+            }
+            for (auto it = s.buckets.rbegin(); it != s.buckets.rend() && used / perColumn < columns; ++it) {
+                size_t first = used / perColumn;
+                size_t last = std::min((used + it->count - 1) / perColumn, columns - 1);
+                for (size_t c = first; c <= last; c++) shown[columns - 1 - c].merge(*it);
+                used += it->count;
+            }
+
+            for (size_t x = 0; x < columns; x++) {
+                if (shown[x].count) m_bitmap.line((long)x, toY(shown[x].min), (long)x, toY(shown[x].max));
+            }
+        }
+    }
+};
+
+#endif
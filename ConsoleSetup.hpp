@@ -3,6 +3,7 @@
 #define CONSOLE_SETUP_HPP
 
 #include <iostream>
+#include <chrono>
 
 #ifdef _WIN32
     #pragma execution_character_set( "utf-8" )
@@ -16,6 +17,7 @@
     #include <unistd.h>
     #include <termios.h>
     #include <sys/ioctl.h>
+    #include <csignal>
 #endif
 
 // --- Global State for restoring terminal ---
@@ -26,11 +28,28 @@
     DWORD originalOutMode;
 #else
     struct termios orig_termios;
+    volatile sig_atomic_t resizeGeneration = 0; // Bumped by SIGWINCH
 #endif
 
 
 // --- Cross-Platform System Functions ---
 
+#ifndef _WIN32
+void onWindowResize(int) {
+    resizeGeneration = resizeGeneration + 1;
+}
+#endif
+
+void installResizeHandler() {
+    #ifndef _WIN32
+        struct sigaction sa = {};
+        sa.sa_handler = onWindowResize;
+        sigemptyset(&sa.sa_mask);
+        sa.sa_flags = SA_RESTART;
+        sigaction(SIGWINCH, &sa, nullptr);
+    #endif
+}
+
 void disableRawMode() {
     std::cout << "\033[?1003l\033[?1006l\033[?25h"; // Disable mouse tracking, show cursor
     
@@ -44,6 +63,7 @@ void disableRawMode() {
 
 void enableRawMode() {
     atexit(disableRawMode);
+    installResizeHandler();
 
     #ifdef _WIN32
         hStdin = GetStdHandle(STD_INPUT_HANDLE);
@@ -91,6 +111,39 @@ void getWindowSize(size_t &width, size_t &height) {
     #endif
 }
 
+// Reports a new window size once resizing has settled for `debounceMs`.
+// On POSIX this only looks at the SIGWINCH counter until then; Windows has no
+// resize signal, so the console size is polled instead.
+bool pollResize(size_t &width, size_t &height, int debounceMs = 30) {
+    static auto lastChange = std::chrono::steady_clock::now();
+    static bool pending = false;
+
+    #ifdef _WIN32
+        static size_t lastW = 0, lastH = 0;
+        size_t w, h;
+        getWindowSize(w, h);
+        if (w != lastW || h != lastH) {
+            lastW = w; lastH = h;
+            lastChange = std::chrono::steady_clock::now();
+            pending = true;
+        }
+    #else
+        static sig_atomic_t seenGeneration = 0;
+        if (resizeGeneration != seenGeneration) {
+            seenGeneration = resizeGeneration;
+            lastChange = std::chrono::steady_clock::now();
+            pending = true;
+        }
+    #endif
+
+    if (!pending) return false;
+    if (std::chrono::steady_clock::now() - lastChange < std::chrono::milliseconds(debounceMs)) return false;
+
+    pending = false;
+    getWindowSize(width, height);
+    return true;
+}
+
 void sleepMs(int ms) {
     #ifdef _WIN32
         Sleep(ms);
@@ -1,33 +1,61 @@
+#ifndef ELEMENTS_HPP
+#define ELEMENTS_HPP
+
 #include "Screen.hpp"
+#include "Bitmap.hpp"
+#include <algorithm>
+#include <cstdint>
 
 enum class Arrangement { HORIZONTAL, VERTICAL, NONE };
+enum class Alignment { START, CENTER, END, STRETCH };
 
 struct pair {
     size_t x, y;
-    pair operator+ (const pair& other) const {
+    constexpr pair operator+ (const pair& other) const {
         return {x + other.x, y + other.y};
     }
-    pair operator+= (const pair& other) {
+    constexpr pair operator+= (const pair& other) {
         x += other.x;
         y += other.y;
         return *this;
     }
-    pair operator- (const pair& other) const {
+    constexpr pair operator- (const pair& other) const {
         return {x - other.x, y - other.y};
     }
-    pair operator= (const pair& other) {
-        x = other.x;
-        y = other.y;
-        return *this;
-    }
-    bool operator>= (const pair& other) const {
+    constexpr bool operator>= (const pair& other) const {
         return x >= other.x || y >= other.y;
     }
-    bool operator== (const pair& other) const {
+    constexpr bool operator== (const pair& other) const {
         return x == other.x && y == other.y;
     }
 };
 
+// Wraps text into the area `constrain`, ellipsizing the last line (shared with static_ui::Text)
+void drawWrappedText(Screen* screen, pair offset, pair constrain, const std::string& text) {
+    std::string displayText = std::to_string(constrain.y) + " " + text;
+    int maxWidth = constrain.x;
+    int lineOffset = 0;
+
+    int cut = 0;
+
+    while (cut < displayText.size()) {
+        if (cut >= maxWidth) {
+            if (lineOffset + 1 >= constrain.y) {
+                screen->putText(offset.x, offset.y + lineOffset, displayText.substr(0, cut - 3) + "...");
+                return; // No more vertical space to render text
+            }
+            screen->putText(offset.x, offset.y + lineOffset, displayText.substr(0, cut));
+            displayText = displayText.substr(cut);
+            lineOffset++;
+
+            cut = 0;
+        }
+        cut++;
+    }
+
+    screen->putText(offset.x, offset.y + lineOffset, displayText);
+}
+
 class Element {
 protected:
     Screen* m_screen = nullptr;
@@ -38,14 +66,24 @@ protected:
     pair m_size = {0, 0}; // The size that the element wants to be (before constraints)
     pair m_constrain = {0, 0}; // The maximum size the element can be (inherited from parent)
     pair m_actualSize = {0, 0}; // The size that the element will actually be (after constraints)
-    pair m_offset = {0, 0}; // The offset of the element from the top-left corner of the parent element
-    pair m_arrangementOffset = {0, 0}; // The offset used for arranging itself on parent
-    pair m_childrenCurrentOffset = {0, 0}; // The current offset for arranging children (accumulates as children are added)
+    pair m_offset = {0, 0}; // The offset of the element from the top-left corner of the screen
+    pair m_arrangementOffset = {0, 0}; // The offset used for arranging itself on parent (inside its border)
 
     bool m_fillMaxWidth = false; // Whether the element should fill the maximum width available to it (ignoring its own size)
     bool m_fillMaxHeight = false; // Whether the element should fill the maximum height available to it (ignoring its own size)
 
+    float m_weight = 0; // Share of the space a Row/Column has left after its other children (0 = use own size)
+    pair m_minSize = {0, 0}; // Lower bound applied after fill/weight (still capped by the constraint)
+    pair m_maxSize = {SIZE_MAX, SIZE_MAX}; // Upper bound applied after fill/weight
+
     Arrangement m_arrangement = Arrangement::NONE;
+    Alignment m_alignment = Alignment::START; // Placement of children across the arrangement axis
+    size_t m_gap = 0; // Space between consecutive children along the arrangement axis
+    bool m_wrap = false; // Start a new line when the next child doesn't fit (weights are ignored then)
+    bool m_visible = true; // Cleared when the parent ran out of space before reaching this element
+
+    bool m_layoutDirty = true; // Set when this element or one of its descendants changed
+    pair m_cachedConstrain = {0, 0}; // Constraint the current layout was computed for
 protected:
 
     void cascadeScreenToChildren() {
@@ -55,53 +93,205 @@ protected:
         }
     }
 
-    void updateChildren() {
-        m_childrenCurrentOffset = {0, 0}; // reset before arranging children
-        
-        for (Element* child : m_children) {
-            child->setArrangementOffset(m_childrenCurrentOffset);
-            if (child->getOffset() >= m_offset + m_actualSize) {
-                return;
-            }
-            child->update();
-            
-            m_childrenCurrentOffset += child->getSize();
-            if (m_arrangement == Arrangement::HORIZONTAL) {
-                m_childrenCurrentOffset.y = 0; // reset y offset for horizontal arrangement
-            } else if (m_arrangement == Arrangement::VERTICAL) {
-                m_childrenCurrentOffset.x = 0; // reset x offset for vertical arrangement
-            } else {
-                m_childrenCurrentOffset = {0, 0}; // reset both offsets for NONE arrangement
-            }
+    // Invalidates the cached layout of this element and everything above it
+    void markDirty() {
+        for (Element* e = this; e && !e->m_layoutDirty; e = e->parent) {
+            e->m_layoutDirty = true;
         }
     }
 
-    void updateActualSize() {
-        
+    // For settings the children read from their parent (arrangement, alignment, wrap)
+    void markChildrenDirty() {
+        markDirty();
+        for (Element* child : m_children) child->m_layoutDirty = true;
+    }
 
+    // Weighted children of a single-line Row/Column take exactly the size they are given
+    bool fillsMainAxis(Arrangement a) const {
+        return m_weight > 0 && parent && parent->m_arrangement == a && !parent->m_wrap;
+    }
+
+    bool stretchesCrossAxis(Arrangement a) const {
+        return parent && parent->m_arrangement == a && parent->m_alignment == Alignment::STRETCH && !parent->m_wrap;
+    }
+
+    void updateActualSize() {
         m_actualSize.x = std::min(m_size.x, m_constrain.x);
         m_actualSize.y = std::min(m_size.y, m_constrain.y);
 
-        if (m_fillMaxWidth) m_actualSize.x = m_constrain.x;
-        if (m_fillMaxHeight) m_actualSize.y = m_constrain.y;
+        if (m_fillMaxWidth || fillsMainAxis(Arrangement::HORIZONTAL) || stretchesCrossAxis(Arrangement::VERTICAL)) m_actualSize.x = m_constrain.x;
+        if (m_fillMaxHeight || fillsMainAxis(Arrangement::VERTICAL) || stretchesCrossAxis(Arrangement::HORIZONTAL)) m_actualSize.y = m_constrain.y;
 
+        m_actualSize.x = std::min(std::max(std::min(m_actualSize.x, m_maxSize.x), m_minSize.x), m_constrain.x);
+        m_actualSize.y = std::min(std::max(std::min(m_actualSize.y, m_maxSize.y), m_minSize.y), m_constrain.y);
     }
 
-    virtual void updateConstrains() {
-        if (!parent) return;
-        m_constrain = parent->m_actualSize + parent->m_offset - m_offset - pair{1, 1}; // -2 for the border of the parent box
+    // Computes the size for `constrain` and places the children. The result is cached
+    // per element, so a clean subtree laid out with the same constraint costs nothing.
+    pair layout(pair constrain) {
+        if (!m_layoutDirty && constrain == m_cachedConstrain) return m_actualSize;
+
+        m_constrain = constrain;
+        updateActualSize();
+        layoutChildren();
+
+        m_cachedConstrain = constrain;
+        m_layoutDirty = false;
+        return m_actualSize;
     }
 
-    void updateOffsets() {
-        if (!parent) return;
-        m_offset = parent->m_offset + m_arrangementOffset + pair{1, 1}; // +1 for the border of the parent box
+    void layoutChildren() {
+        // Children sit inside the border of this element
+        bool hasRoom = m_actualSize.x >= 2 && m_actualSize.y >= 2;
+        pair inner = hasRoom ? m_actualSize - pair{2, 2} : pair{0, 0};
+
+        if (m_arrangement == Arrangement::NONE) {
+            for (Element* child : m_children) {
+                child->m_arrangementOffset = {0, 0};
+                child->m_visible = hasRoom;
+                if (hasRoom) child->layout(inner);
+            }
+        } else if (m_wrap) {
+            layoutWrapped(inner, hasRoom);
+        } else {
+            layoutLine(inner, hasRoom);
+        }
     }
 
-    void setArrangementOffset(pair offset) {
-        m_arrangementOffset = offset;
-        updateOffsets();
+    // Single-line flex pass: children with a weight split whatever the others left over
+    void layoutLine(pair inner, bool hasRoom) {
+        bool horizontal = m_arrangement == Arrangement::HORIZONTAL;
+        auto main = [horizontal](pair& p) -> size_t& { return horizontal ? p.x : p.y; };
+        auto cross = [horizontal](pair& p) -> size_t& { return horizontal ? p.y : p.x; };
+        size_t innerMain = main(inner), innerCross = cross(inner);
+
+        // Measure the unweighted children in order; each may use what is left at its position
+        size_t used = 0;
+        float totalWeight = 0;
+        size_t weighted = 0;
+        bool outOfSpace = !hasRoom;
+        for (size_t i = 0; i < m_children.size(); i++) {
+            Element* child = m_children[i];
+            child->m_visible = !outOfSpace && used <= innerMain;
+            if (!child->m_visible) { outOfSpace = true; continue; }
+
+            if (child->m_weight > 0) {
+                totalWeight += child->m_weight;
+                weighted++;
+            } else {
+                pair constrain = {0, 0};
+                main(constrain) = innerMain - used;
+                cross(constrain) = innerCross;
+                pair childSize = child->layout(constrain);
+                used += main(childSize);
+            }
+            if (i + 1 < m_children.size()) used += m_gap;
+        }
+
+        // Size the weighted children and place everyone; each takes its share of what is
+        // still unclaimed, so the last one absorbs the rounding remainder
+        size_t leftover = used < innerMain ? innerMain - used : 0;
+        size_t position = 0;
+        for (Element* child : m_children) {
+            if (!child->m_visible || position > innerMain) {
+                child->m_visible = false;
+                continue;
+            }
+
+            if (child->m_weight > 0) {
+                size_t share = --weighted == 0 ? leftover : std::min((size_t)(leftover * (child->m_weight / totalWeight)), leftover);
+                leftover -= share;
+                totalWeight -= child->m_weight;
+
+                pair constrain = {0, 0};
+                main(constrain) = std::min(share, innerMain - position);
+                cross(constrain) = innerCross;
+                child->layout(constrain);
+            }
+
+            pair offset = {0, 0};
+            main(offset) = position;
+            cross(offset) = alignedCrossOffset(innerCross, cross(child->m_actualSize));
+            child->m_arrangementOffset = offset;
+
+            position += main(child->m_actualSize) + m_gap;
+        }
     }
 
+    // Multi-line pass: children flow along the main axis and wrap onto a new line
+    void layoutWrapped(pair inner, bool hasRoom) {
+        bool horizontal = m_arrangement == Arrangement::HORIZONTAL;
+        auto main = [horizontal](pair& p) -> size_t& { return horizontal ? p.x : p.y; };
+        auto cross = [horizontal](pair& p) -> size_t& { return horizontal ? p.y : p.x; };
+        size_t innerMain = main(inner), innerCross = cross(inner);
+
+        size_t linePos = 0, lineCross = 0, crossPos = 0;
+        size_t lineStart = 0;
+        bool outOfSpace = !hasRoom;
+
+        for (size_t i = 0; i <= m_children.size(); i++) {
+            Element* child = i < m_children.size() ? m_children[i] : nullptr;
+
+            size_t wanted = 0;
+            if (child) {
+                pair desired = child->m_size;
+                wanted = std::max(main(desired), main(child->m_minSize));
+            }
+
+            // Close the current line: align its children now that its height is known
+            bool breakLine = child && linePos > 0 && wanted > innerMain - std::min(linePos, innerMain);
+            if (!child || breakLine) {
+                for (size_t j = lineStart; j < i; j++) {
+                    Element* placed = m_children[j];
+                    if (!placed->m_visible) continue;
+                    cross(placed->m_arrangementOffset) += alignedCrossOffset(lineCross, cross(placed->m_actualSize));
+                }
+                if (!child) break;
+                crossPos += lineCross + m_gap;
+                linePos = lineCross = 0;
+                lineStart = i;
+            }
+
+            child->m_visible = !outOfSpace && crossPos <= innerCross && linePos <= innerMain;
+            if (!child->m_visible) { outOfSpace = true; continue; }
+
+            pair constrain = {0, 0};
+            main(constrain) = innerMain - linePos;
+            cross(constrain) = innerCross - crossPos;
+            pair childSize = child->layout(constrain);
+
+            pair offset = {0, 0};
+            main(offset) = linePos;
+            cross(offset) = crossPos;
+            child->m_arrangementOffset = offset;
+
+            linePos += main(childSize) + m_gap;
+            lineCross = std::max(lineCross, cross(childSize));
+        }
+    }
+
+    size_t alignedCrossOffset(size_t available, size_t childCross) const {
+        if (childCross >= available) return 0;
+        switch (m_alignment) {
+            case Alignment::CENTER: return (available - childCross) / 2;
+            case Alignment::END: return available - childCross;
+            default: return 0;
+        }
+    }
+
+    // Draws this element and its visible children at their absolute position
+    void paint() {
+        drawGraphics();
+        for (Element* child : m_children) {
+            if (!child->m_visible) continue;
+            child->m_offset = m_offset + child->m_arrangementOffset + pair{1, 1}; // +1 for the border of the parent box
+            child->paint();
+        }
+    }
+
+    // Constraint of a root element; children get theirs from the parent's layout
+    virtual void updateConstrains() {}
+
     virtual void drawGraphics() {};
 
 public:
@@ -125,28 +315,45 @@ public:
             this->addChild(child);
         }
     }
+
+    // Children are created with new and owned by their parent, so elements can't be copied
+    Element(const Element&) = delete;
+    Element& operator=(const Element&) = delete;
+
+    virtual ~Element() {
+        for (Element* child : m_children) delete child;
+    }
+
+    // Lays out the tree below this element without drawing it
+    void updateLayout() {
+        updateConstrains();
+        layout(m_constrain);
+    }
     
     virtual void update() {
-        updateOffsets();
-        updateConstrains();
-        updateActualSize();
-        drawGraphics();
-        updateChildren();
+        updateLayout();
+        paint();
     };
 
     void addChild(Element* newChild) {
         newChild->parent = this; 
         m_children.push_back(newChild);
+        markDirty();
     }
 
-    Element* size(size_t w, size_t h) { m_size = {w, h}; return this; }
-    Element* width(size_t w) { m_size.x = w; return this; }
-    Element* height(size_t h) { m_size.y = h; return this; }
-    Element* fillMaxWidth() { m_fillMaxWidth = true; return this; }
-    Element* fillMaxHeight() { m_fillMaxHeight = true; return this; }
-    Element* fillMaxSize() { m_fillMaxWidth = true; m_fillMaxHeight = true; return this; }
-
+    Element* size(size_t w, size_t h) { m_size = {w, h}; markDirty(); return this; }
+    Element* width(size_t w) { m_size.x = w; markDirty(); return this; }
+    Element* height(size_t h) { m_size.y = h; markDirty(); return this; }
+    Element* fillMaxWidth() { m_fillMaxWidth = true; markDirty(); return this; }
+    Element* fillMaxHeight() { m_fillMaxHeight = true; markDirty(); return this; }
+    Element* fillMaxSize() { m_fillMaxWidth = true; m_fillMaxHeight = true; markDirty(); return this; }
 
+    Element* weight(float w) { m_weight = w; markDirty(); return this; }
+    Element* minSize(size_t w, size_t h) { m_minSize = {w, h}; markDirty(); return this; }
+    Element* maxSize(size_t w, size_t h) { m_maxSize = {w, h}; markDirty(); return this; }
+    Element* gap(size_t g) { m_gap = g; markDirty(); return this; }
+    Element* align(Alignment a) { m_alignment = a; markChildrenDirty(); return this; }
+    Element* wrap(bool w = true) { m_wrap = w; markChildrenDirty(); return this; }
 
     pair getSize() { return m_actualSize; }
     pair getOffset() { return m_offset; }
@@ -160,25 +367,66 @@ struct Terminal : public Element {
         cascadeScreenToChildren(); // Ensure all children have the screen reference
     }
 
+    // Follows the screen, so a resize (pollResize + Screen::resize) is picked up on the next update
     void updateConstrains() override {
         pair newConstrain = {m_screen->width, m_screen->height};
+        m_size = newConstrain;
         m_constrain = newConstrain;
     }
 };
 
 struct Canvas : public Element {
+    std::string m_title = "Canvas";
+    bool m_pixelMode = false;
+    Bitmap m_bitmap; // Sized to the interior of the box when in pixel mode
+
     Canvas(size_t w = 0, size_t h = 0, std::initializer_list<Element*> list = {}): Element(list) {
         m_size = {w, h};
         m_arrangement = Arrangement::NONE;
     }
 
     void drawGraphics () override {
-        Box box(m_actualSize.x, m_actualSize.y, "Canvas");
+        Box box(m_actualSize.x, m_actualSize.y, m_title);
         m_screen->putBox(m_offset.x, m_offset.y, box);
+        if (m_pixelMode) drawPixels();
     }
 
     void setArrangement(Arrangement a) {
         m_arrangement = a;
+        markChildrenDirty();
+    }
+
+    // Turns the canvas into a plotting surface; draw into pixels() between updates
+    Canvas* pixelMode(PixelMode mode = PixelMode::BRAILLE) {
+        m_pixelMode = true;
+        m_bitmap.mode = mode;
+        m_bitmap.resize(m_bitmap.cellWidth, m_bitmap.cellHeight);
+        return this;
+    }
+
+    // The bitmap is resized (and cleared) whenever the canvas size changes
+    Bitmap& pixels() { return m_bitmap; }
+
+protected:
+    // Matches the bitmap to the interior of the box
+    void fitBitmap() {
+        size_t w = m_actualSize.x >= 2 ? m_actualSize.x - 2 : 0;
+        size_t h = m_actualSize.y >= 2 ? m_actualSize.y - 2 : 0;
+        if (w != m_bitmap.cellWidth || h != m_bitmap.cellHeight) {
+            m_bitmap.resize(w, h);
+        }
+    }
+
+    void drawPixels() {
+        fitBitmap();
+        size_t w = m_bitmap.cellWidth, h = m_bitmap.cellHeight;
+
+        // One pass: each cell's mask indexes straight into the glyph table
+        for (size_t cy = 0; cy < h; cy++) {
+            for (size_t cx = 0; cx < w; cx++) {
+                m_screen->putChar(m_offset.x + 1 + cx, m_offset.y + 1 + cy, Bitmap::glyph(m_bitmap.mode, m_bitmap.cellMask(cx, cy)));
+            }
+        }
     }
 };
 
@@ -214,31 +462,7 @@ struct Text : public Element {
     }
 
     void drawGraphics () override {
-        
-        std::string displayText = std::to_string(m_constrain.y) + " " + m_text;
-        int maxWidth = m_constrain.x;
-        int lineOffset = 0;
-
-        int cut = 0;
-
-        while (cut < displayText.size()) {
-            if (cut >= maxWidth) {
-                if (lineOffset + 1 >= m_constrain.y) {
-                    m_screen->putText(m_offset.x, m_offset.y + lineOffset, displayText.substr(0, cut - 3) + "...");
-                    return; // No more vertical space to render text
-                }
-                m_screen->putText(m_offset.x, m_offset.y + lineOffset, displayText.substr(0, cut));
-                displayText = displayText.substr(cut);
-                lineOffset++;
-
-                cut = 0;
-            }
-            cut++;
-        }
-
-        m_screen->putText(m_offset.x, m_offset.y + lineOffset, displayText);
-
-
+        drawWrappedText(m_screen, m_offset, m_constrain, m_text);
     }
 };
 
@@ -250,4 +474,6 @@ struct Spacer : public Element {
     void drawGraphics () override {
         // Empty space :P
     }
-};
\ No newline at end of file
+};
+
+#endif
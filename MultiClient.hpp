@@ -0,0 +1,298 @@
+#ifndef MULTI_CLIENT_HPP
+#define MULTI_CLIENT_HPP
+
+// POSIX only: ptys and Unix domain sockets
+#ifndef _WIN32
+
+#include "Elements.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+// --- One app instance serving many terminals ---
+// Layout and paint run once per distinct terminal size, into a headless Screen shared
+// by every client of that size. Each client keeps its own DiffRenderer (front buffer)
+// and output queue; a client that hasn't drained the previous frame simply skips
+// this one, so a slow link never holds back the others.
+//
+// Every size gets its own element tree from the build function, built when the first
+// client of that size appears and deleted when the last one leaves. The trees hold
+// layout and paint state only: app state (text, counters, samples) lives outside them
+// and the build function binds the new tree to it, so all sizes show the same data
+// and a tree built later starts from the current state.
+//
+//     SessionServer server(buildApp);
+//     server.listen("/tmp/dashboard.sock");   // clients attach with tools/attach
+//     server.addTty(open("/dev/pts/7", O_RDWR | O_NOCTTY));
+//     while (true) {
+//         server.pump(33);
+//         server.renderFrame();
+//     }
+//
+// For charts that state is a shared ChartData: producers push() into it from any
+// thread, and the Chart in each tree plots it at its own width.
+//
+//     auto cpu = std::make_shared<ChartData>(10000);   // last 10k samples
+//     SessionServer server([cpu](Screen* s) {
+//         return new Terminal(s, { (new Chart(cpu))->fillMaxSize() });
+//     });
+
+struct ClientSession {
+    int fd = -1;
+    bool isTty = false;           // size comes from TIOCGWINSZ instead of resize reports
+    bool isSocket = false;        // written with send() rather than write()
+    struct termios savedTermios;  // restored when a tty client goes away
+    size_t width = 0, height = 0; // 0 until the size is known
+    DiffRenderer renderer;
+    std::string pending;          // encoded output the fd hasn't accepted yet
+    std::string input;            // bytes not yet split into resize reports / app input
+    size_t droppedFrames = 0;
+    bool closed = false;
+};
+
+struct SessionServer {
+    struct SizeGroup {
+        std::unique_ptr<Screen> screen;
+        Terminal* app = nullptr;
+        bool used = false;
+    };
+
+    std::function<Terminal*(Screen*)> m_build;
+    std::function<void(ClientSession&, const std::string&)> onInput; // optional, UI thread
+    std::vector<std::unique_ptr<ClientSession>> m_clients;
+    std::map<std::pair<size_t, size_t>, SizeGroup> m_groups;
+    int m_listenFd = -1;
+
+    explicit SessionServer(std::function<Terminal*(Screen*)> build) : m_build(std::move(build)) {}
+
+    ~SessionServer() {
+        for (auto& c : m_clients) c->closed = true;
+        removeClosed();
+        for (auto& g : m_groups) delete g.second.app;
+        if (m_listenFd >= 0) ::close(m_listenFd);
+    }
+
+    // Accepts clients on a Unix socket. Clients announce their size with the xterm
+    // report "ESC [ 8 ; rows ; cols t" and resend it whenever they are resized.
+    bool listen(const std::string& path) {
+        m_listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (m_listenFd < 0) return false;
+
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) return false;
+        std::copy(path.begin(), path.end(), addr.sun_path);
+        unlink(path.c_str());
+
+        if (bind(m_listenFd, (sockaddr*)&addr, sizeof(addr)) < 0 || ::listen(m_listenFd, 16) < 0) {
+            ::close(m_listenFd);
+            m_listenFd = -1;
+            return false;
+        }
+        setNonBlocking(m_listenFd);
+        return true;
+    }
+
+    // Serves a terminal device directly, e.g. an operator's /dev/pts/N opened by path.
+    // It is put in raw mode like enableRawMode() and its size is read every frame.
+    ClientSession& addTty(int fd) {
+        ClientSession& c = addClient(fd);
+        c.isTty = true;
+        tcgetattr(fd, &c.savedTermios);
+        struct termios raw = c.savedTermios;
+        raw.c_lflag &= ~(ECHO | ICANON | ISIG | IEXTEN);
+        raw.c_iflag &= ~(IXON | ICRNL | BRKINT | INPCK | ISTRIP);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSAFLUSH, &raw);
+        return c;
+    }
+
+    // Waits up to `timeoutMs` for new clients, input or writable sockets and handles them
+    void pump(int timeoutMs) {
+        std::vector<pollfd> fds;
+        if (m_listenFd >= 0) fds.push_back({m_listenFd, POLLIN, 0});
+        for (auto& c : m_clients) {
+            short events = POLLIN;
+            if (!c->pending.empty()) events |= POLLOUT;
+            fds.push_back({c->fd, events, 0});
+        }
+        if (::poll(fds.data(), fds.size(), timeoutMs) <= 0) return;
+
+        size_t i = 0;
+        if (m_listenFd >= 0) {
+            if (fds[i].revents & POLLIN) acceptClients();
+            i++;
+        }
+        for (size_t c = 0; i < fds.size(); i++, c++) {
+            ClientSession& client = *m_clients[c];
+            if (fds[i].revents & (POLLERR | POLLHUP)) client.closed = true;
+            if (fds[i].revents & POLLIN) readFrom(client);
+            if (fds[i].revents & POLLOUT) flush(client);
+        }
+        removeClosed();
+    }
+
+    // Lays out and paints each distinct size once, then gives every ready client its diff
+    void renderFrame() {
+        for (auto& g : m_groups) g.second.used = false;
+
+        for (auto& c : m_clients) {
+            if (c->isTty) updateTtySize(*c);
+            if (!c->width || !c->height) continue;
+            m_groups[{c->width, c->height}].used = true;
+        }
+
+        // Sizes nobody uses any more
+        for (auto it = m_groups.begin(); it != m_groups.end();) {
+            if (!it->second.used) { delete it->second.app; it = m_groups.erase(it); }
+            else ++it;
+        }
+
+        for (auto& entry : m_groups) {
+            SizeGroup& g = entry.second;
+            if (!g.screen) {
+                g.screen = std::make_unique<Screen>(entry.first.first, entry.first.second);
+                g.app = m_build(g.screen.get());
+            }
+            g.app->update();
+        }
+
+        for (auto& c : m_clients) {
+            if (!c->width || !c->height) continue;
+            if (!c->pending.empty()) {
+                c->droppedFrames++; // still sending an older frame
+                continue;
+            }
+            c->pending = c->renderer.render(m_groups[{c->width, c->height}].screen->buffer);
+            flush(*c);
+        }
+        removeClosed();
+    }
+
+    size_t clientCount() const { return m_clients.size(); }
+
+    // Calls fn on the app tree of every size currently being served. UI thread only:
+    // renderFrame() builds and deletes trees. Other threads post() to uiUpdates().
+    void forEachApp(const std::function<void(Terminal*)>& fn) {
+        for (auto& g : m_groups) {
+            if (g.second.app) fn(g.second.app);
+        }
+    }
+
+private:
+    static void setNonBlocking(int fd) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    ClientSession& addClient(int fd) {
+        setNonBlocking(fd);
+        m_clients.push_back(std::make_unique<ClientSession>());
+        ClientSession& c = *m_clients.back();
+        c.fd = fd;
+        struct stat st;
+        c.isSocket = fstat(fd, &st) == 0 && S_ISSOCK(st.st_mode);
+        c.pending = "\033[?25l"; // hide cursor, like enableRawMode()
+        flush(c);
+        return c;
+    }
+
+    void acceptClients() {
+        int fd;
+        while ((fd = accept(m_listenFd, nullptr, nullptr)) >= 0) addClient(fd);
+    }
+
+    void updateTtySize(ClientSession& c) {
+        struct winsize ws;
+        if (ioctl(c.fd, TIOCGWINSZ, &ws) == 0 && ws.ws_col && ws.ws_row) setSize(c, ws.ws_col, ws.ws_row);
+    }
+
+    void setSize(ClientSession& c, size_t w, size_t h) {
+        if (w == c.width && h == c.height) return;
+        c.width = w;
+        c.height = h;
+        c.renderer.invalidate();
+    }
+
+    void readFrom(ClientSession& c) {
+        char buf[1024];
+        ssize_t n;
+        while ((n = read(c.fd, buf, sizeof(buf))) > 0) c.input.append(buf, n);
+        if (n == 0 && !c.isTty) c.closed = true; // a raw tty returns 0 when idle
+
+        // Pull out resize reports, hand everything else to the app
+        std::string forApp;
+        size_t i = 0;
+        while (i < c.input.size()) {
+            size_t esc = c.input.find("\033[8;", i);
+            if (esc == std::string::npos) {
+                // Keep a trailing partial escape for the next read
+                size_t keep = c.input.rfind('\033');
+                if (keep != std::string::npos && keep >= i && c.input.size() - keep < 4) {
+                    forApp.append(c.input, i, keep - i);
+                    i = keep;
+                    break;
+                }
+                forApp.append(c.input, i, std::string::npos);
+                i = c.input.size();
+                break;
+            }
+            size_t end = c.input.find('t', esc);
+            if (end == std::string::npos) {
+                forApp.append(c.input, i, esc - i);
+                i = esc;
+                break;
+            }
+            forApp.append(c.input, i, esc - i);
+
+            unsigned rows = 0, cols = 0;
+            if (std::sscanf(c.input.c_str() + esc, "\033[8;%u;%ut", &rows, &cols) == 2 && rows && cols) {
+                setSize(c, cols, rows);
+            }
+            i = end + 1;
+        }
+        c.input.erase(0, i);
+
+        if (!forApp.empty() && onInput) onInput(c, forApp);
+    }
+
+    void flush(ClientSession& c) {
+        while (!c.pending.empty()) {
+            // send() so a vanished socket peer doesn't raise SIGPIPE
+            ssize_t n = c.isSocket ? send(c.fd, c.pending.data(), c.pending.size(), MSG_NOSIGNAL)
+                                   : write(c.fd, c.pending.data(), c.pending.size());
+            if (n > 0) {
+                c.pending.erase(0, n);
+            } else {
+                if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) c.closed = true;
+                break;
+            }
+        }
+    }
+
+    void removeClosed() {
+        for (size_t i = 0; i < m_clients.size();) {
+            if (m_clients[i]->closed) {
+                ClientSession& c = *m_clients[i];
+                if (c.isTty) {
+                    (void)!write(c.fd, "\033[?25h", 6); // show cursor, like disableRawMode()
+                    tcsetattr(c.fd, TCSAFLUSH, &c.savedTermios);
+                }
+                ::close(c.fd);
+                m_clients.erase(m_clients.begin() + i);
+            } else {
+                i++;
+            }
+        }
+    }
+};
+
+#endif
+#endif
@@ -0,0 +1,200 @@
+#ifndef RECORDER_HPP
+#define RECORDER_HPP
+
+#include "Renderer.hpp"
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// --- Session recording ---
+// File layout: "TUIREC1\n", then records of
+//   'R' dt w h                                      screen (re)size
+//   'F' dt runCount { y x count { len bytes }* }*   changed cell runs
+//   'I' dt len bytes                                input read by the app
+// All integers are LEB128 varints and dt is microseconds since the previous record,
+// so an idle frame costs 3 bytes and a one-cell change about 8.
+
+static const char RECORDING_MAGIC[] = "TUIREC1\n";
+
+struct SessionRecorder {
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int FLUSH_INTERVAL_MS = 1000;
+
+    std::ofstream m_out;
+    CellBuffer m_last; // Frame as of the last record
+    Clock::time_point m_lastTime;
+    Clock::time_point m_lastFlush;
+
+    bool open(const std::string& path) {
+        m_out.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_out) return false;
+        m_out.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC) - 1);
+        m_lastTime = m_lastFlush = Clock::now();
+        m_last.clear();
+        return true;
+    }
+
+    bool isOpen() const { return m_out.is_open(); }
+
+    void recordInput(const char* buf, int n) {
+        if (!isOpen() || n <= 0) return;
+        beginRecord('I');
+        writeVarint(n);
+        m_out.write(buf, n);
+        flushIfDue();
+    }
+
+    // Logs the cells that differ from the previous recorded frame
+    void recordFrame(const CellBuffer& frame) {
+        if (!isOpen()) return;
+
+        size_t height = frame.size(), width = height ? frame[0].size() : 0;
+        if (m_last.size() != height || (height && m_last[0].size() != width)) {
+            beginRecord('R');
+            writeVarint(width);
+            writeVarint(height);
+            m_last.assign(height, std::vector<std::string>(width, ""));
+        }
+
+        // Collect runs of changed cells first; the count precedes them in the file
+        struct Run { size_t y, x, count; };
+        std::vector<Run> runs;
+        for (size_t y = 0; y < height; y++) {
+            const std::vector<std::string>& row = frame[y];
+            std::vector<std::string>& last = m_last[y];
+            size_t x = 0;
+            while (x < width) {
+                if (row[x] == last[x]) { x++; continue; }
+                size_t start = x;
+                while (x < width && row[x] != last[x]) { last[x] = row[x]; x++; }
+                runs.push_back({y, start, x - start});
+            }
+        }
+
+        beginRecord('F');
+        writeVarint(runs.size());
+        for (const Run& run : runs) {
+            writeVarint(run.y);
+            writeVarint(run.x);
+            writeVarint(run.count);
+            for (size_t i = 0; i < run.count; i++) {
+                const std::string& cell = frame[run.y][run.x + i];
+                writeVarint(cell.size());
+                m_out.write(cell.data(), cell.size());
+            }
+        }
+        flushIfDue();
+    }
+
+    // Writes out buffered records; also done on destruction
+    void close() {
+        if (isOpen()) m_out.close();
+    }
+
+private:
+    // Flushing every record would put a syscall in the render path being recorded, so
+    // records are written out at most once per FLUSH_INTERVAL_MS (and when closed)
+    void flushIfDue() {
+        if (m_lastTime - m_lastFlush < std::chrono::milliseconds(FLUSH_INTERVAL_MS)) return;
+        m_out.flush();
+        m_lastFlush = m_lastTime;
+    }
+
+    void beginRecord(char type) {
+        auto now = Clock::now();
+        uint64_t dt = std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastTime).count();
+        m_lastTime = now;
+        m_out.put(type);
+        writeVarint(dt);
+    }
+
+    void writeVarint(uint64_t v) {
+        while (v >= 0x80) {
+            m_out.put((char)(v | 0x80));
+            v >>= 7;
+        }
+        m_out.put((char)v);
+    }
+};
+
+// --- Reads a recording back one record at a time ---
+struct SessionReader {
+    struct Record {
+        char type = 0;
+        uint64_t timeUs = 0;      // since the start of the session
+        size_t width = 0, height = 0;
+        std::string input;
+    };
+
+    std::ifstream m_in;
+    uint64_t m_time = 0;
+    CellBuffer frame; // Screen contents after the last 'F' record
+
+    bool open(const std::string& path) {
+        m_in.open(path, std::ios::binary);
+        char magic[sizeof(RECORDING_MAGIC) - 1];
+        if (!m_in.read(magic, sizeof(magic))) return false;
+        return std::string(magic, sizeof(magic)) == RECORDING_MAGIC;
+    }
+
+    // Reads the next record, applying frames and resizes to `frame`. False at end of file.
+    bool next(Record& r) {
+        int type = m_in.get();
+        if (type == EOF) return false;
+
+        uint64_t dt;
+        if (!readVarint(dt)) return false;
+        m_time += dt;
+        r = Record();
+        r.type = (char)type;
+        r.timeUs = m_time;
+
+        if (type == 'R') {
+            uint64_t w, h;
+            if (!readVarint(w) || !readVarint(h)) return false;
+            r.width = w;
+            r.height = h;
+            frame.assign(h, std::vector<std::string>(w, " "));
+        } else if (type == 'I') {
+            uint64_t n;
+            if (!readVarint(n)) return false;
+            r.input.resize(n);
+            if (!m_in.read(&r.input[0], n)) return false;
+        } else if (type == 'F') {
+            uint64_t runs;
+            if (!readVarint(runs)) return false;
+            for (uint64_t i = 0; i < runs; i++) {
+                uint64_t y, x, count;
+                if (!readVarint(y) || !readVarint(x) || !readVarint(count)) return false;
+                if (y >= frame.size() || x + count > frame[y].size()) return false;
+                for (uint64_t c = 0; c < count; c++) {
+                    uint64_t len;
+                    if (!readVarint(len)) return false;
+                    std::string& cell = frame[y][x + c];
+                    cell.resize(len);
+                    if (len && !m_in.read(&cell[0], len)) return false;
+                }
+            }
+        } else {
+            return false; // unknown record
+        }
+        return true;
+    }
+
+private:
+    bool readVarint(uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int byte = m_in.get();
+            if (byte == EOF) return false;
+            v |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+};
+
+#endif
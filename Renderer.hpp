@@ -0,0 +1,213 @@
+#ifndef RENDERER_HPP
+#define RENDERER_HPP
+
+#include "TerminalCaps.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using CellBuffer = std::vector<std::vector<std::string>>;
+
+// --- Turns a cell buffer into the shortest escape stream the terminal understands ---
+struct FrameEncoder {
+    TerminalCaps caps;
+
+    static void appendCsi(std::string& out, size_t n, char final) {
+        out += "\033[";
+        out += std::to_string(n);
+        out += final;
+    }
+
+    static size_t csiLength(size_t n) {
+        return 3 + std::to_string(n).size();
+    }
+
+    // Writes cells [from, to) of a row, assuming the cursor already sits on `from`.
+    // Leaves the cursor just after `to - 1`, except when the run reaches the end of
+    // the row and is cleared with EL (the cursor then stays at the start of the run).
+    void encodeCells(std::string& out, const std::vector<std::string>& row, size_t from, size_t to) const {
+        size_t x = from;
+        while (x < to) {
+            const std::string& cell = row[x];
+            size_t run = 1;
+            while (x + run < to && row[x + run] == cell) run++;
+
+            if (cell == " " && x + run == row.size() && run > 3) {
+                out += "\033[K"; // EL: blank the rest of the line
+            } else if (cell == " " && caps.ech && run > 2 * csiLength(run)) {
+                appendCsi(out, run, 'X'); // ECH doesn't move the cursor
+                appendCsi(out, run, 'C');
+            } else if (caps.rep && run > 1 && csiLength(run - 1) < (run - 1) * cell.size()) {
+                out += cell;
+                appendCsi(out, run - 1, 'b');
+            } else {
+                for (size_t i = 0; i < run; i++) out += cell;
+            }
+            x += run;
+        }
+    }
+
+    void beginFrame(std::string& out) const {
+        if (caps.syncOutput) out += "\033[?2026h";
+    }
+
+    void endFrame(std::string& out) const {
+        if (caps.syncOutput) out += "\033[?2026l";
+    }
+
+    void encodeFull(std::string& out, const CellBuffer& buffer) const {
+        out += "\033[H";
+        for (size_t y = 0; y < buffer.size(); ++y) {
+            encodeCells(out, buffer[y], 0, buffer[y].size());
+            if (y + 1 < buffer.size()) out += "\r\n";
+        }
+    }
+
+    std::string encode(const CellBuffer& buffer) const {
+        std::string out;
+        beginFrame(out);
+        encodeFull(out, buffer);
+        endFrame(out);
+        return out;
+    }
+};
+
+// --- Keeps a copy of what the terminal shows and only sends the difference ---
+struct DiffRenderer {
+    FrameEncoder encoder;
+
+    CellBuffer front;                    // What the terminal currently displays
+    std::vector<uint64_t> frontHashes;   // One hash per front row
+    bool invalid = true;                 // Next frame is sent in full
+
+    static const size_t MIN_SCROLL_ROWS = 3;   // Shorter moves are cheaper to repaint
+    static const size_t MAX_SCROLLS = 4;       // Scroll operations tried per frame
+    static const size_t MERGE_GAP = 4;         // Unchanged cells rewritten instead of moving the cursor
+
+    static uint64_t hashRow(const std::vector<std::string>& row) {
+        uint64_t h = 1469598103934665603ull; // FNV-1a
+        for (const std::string& cell : row) {
+            for (unsigned char c : cell) { h ^= c; h *= 1099511628211ull; }
+            h ^= 0xff; h *= 1099511628211ull; // cell separator
+        }
+        return h;
+    }
+
+    void invalidate() { invalid = true; }
+
+    std::string render(const CellBuffer& back) {
+        std::string out;
+        encoder.beginFrame(out);
+        size_t bodyStart = out.size();
+
+        bool sizeChanged = front.size() != back.size() || (!back.empty() && front[0].size() != back[0].size());
+        if (invalid || sizeChanged) {
+            encoder.encodeFull(out, back);
+            front = back;
+            frontHashes.resize(back.size());
+            for (size_t y = 0; y < back.size(); ++y) frontHashes[y] = hashRow(back[y]);
+            invalid = false;
+        } else {
+            std::vector<uint64_t> backHashes(back.size());
+            for (size_t y = 0; y < back.size(); ++y) backHashes[y] = hashRow(back[y]);
+
+            if (encoder.caps.scrollRegion) {
+                for (size_t i = 0; i < MAX_SCROLLS && scrollFront(out, back, backHashes); i++) {}
+            }
+            for (size_t y = 0; y < back.size(); ++y) {
+                if (backHashes[y] == frontHashes[y] && back[y] == front[y]) continue;
+                diffRow(out, back, y);
+                frontHashes[y] = backHashes[y];
+            }
+        }
+
+        if (out.size() == bodyStart) return std::string(); // nothing changed, nothing to send
+        encoder.endFrame(out);
+        return out;
+    }
+
+private:
+    // Rewrites the changed spans of one row and brings `front` up to date
+    void diffRow(std::string& out, const CellBuffer& back, size_t y) {
+        const std::vector<std::string>& row = back[y];
+        std::vector<std::string>& shown = front[y];
+        size_t x = 0;
+        while (x < row.size()) {
+            if (row[x] == shown[x]) { x++; continue; }
+
+            size_t start = x, end = x + 1, same = 0;
+            for (size_t i = end; i < row.size() && same <= MERGE_GAP; i++) {
+                if (row[i] == shown[i]) { same++; }
+                else { same = 0; end = i + 1; }
+            }
+
+            out += "\033[" + std::to_string(y + 1) + ";" + std::to_string(start + 1) + "H";
+            encoder.encodeCells(out, row, start, end);
+            std::copy(row.begin() + start, row.begin() + end, shown.begin() + start);
+            x = end;
+        }
+    }
+
+    // Finds the longest run of rows that moved vertically as a block, scrolls it into
+    // place with DECSTBM + SU/SD and shifts `front` to match. Returns false if nothing
+    // worth scrolling was found.
+    bool scrollFront(std::string& out, const CellBuffer& back, const std::vector<uint64_t>& backHashes) {
+        std::unordered_map<uint64_t, long> rowByHash;
+        rowByHash.reserve(front.size());
+        for (size_t y = 0; y < front.size(); ++y) {
+            auto it = rowByHash.find(frontHashes[y]);
+            if (it == rowByHash.end()) rowByHash.emplace(frontHashes[y], (long)y);
+            else it->second = -1; // ambiguous (e.g. blank rows), never an anchor
+        }
+
+        long bestStart = 0, bestLen = 0, bestDelta = 0;
+        long runStart = 0, runLen = 0, runDelta = 0;
+        for (long y = 0; y < (long)back.size(); ++y) {
+            long delta = 0;
+            if (backHashes[y] != frontHashes[y]) {
+                auto it = rowByHash.find(backHashes[y]);
+                if (it != rowByHash.end() && it->second >= 0 && back[y] == front[it->second]) {
+                    delta = it->second - y;
+                }
+            }
+
+            if (delta != 0 && delta == runDelta && runLen > 0) {
+                runLen++;
+            } else {
+                runStart = y; runDelta = delta; runLen = delta != 0 ? 1 : 0;
+            }
+            if (runLen > bestLen) { bestStart = runStart; bestLen = runLen; bestDelta = runDelta; }
+        }
+        if (bestLen < (long)MIN_SCROLL_ROWS) return false;
+
+        // Back rows [bestStart, bestStart + bestLen) came from front rows shifted by bestDelta
+        long top = std::min(bestStart, bestStart + bestDelta);
+        long bottom = std::max(bestStart, bestStart + bestDelta) + bestLen - 1;
+        size_t amount = (size_t)std::abs(bestDelta);
+
+        out += "\033[" + std::to_string(top + 1) + ";" + std::to_string(bottom + 1) + "r";
+        out += "\033[" + std::to_string(amount) + (bestDelta > 0 ? "S" : "T");
+        out += "\033[r"; // reset margins (also homes the cursor)
+
+        size_t width = front.empty() ? 0 : front[0].size();
+        std::vector<std::string> blank(width, " ");
+        uint64_t blankHash = hashRow(blank);
+
+        auto first = front.begin() + top, last = front.begin() + bottom + 1;
+        auto hFirst = frontHashes.begin() + top, hLast = frontHashes.begin() + bottom + 1;
+        if (bestDelta > 0) {
+            std::rotate(first, first + amount, last);
+            std::rotate(hFirst, hFirst + amount, hLast);
+            for (long y = bottom + 1 - (long)amount; y <= bottom; ++y) { front[y] = blank; frontHashes[y] = blankHash; }
+        } else {
+            std::rotate(first, last - amount, last);
+            std::rotate(hFirst, hLast - amount, hLast);
+            for (long y = top; y < top + (long)amount; ++y) { front[y] = blank; frontHashes[y] = blankHash; }
+        }
+        return true;
+    }
+};
+
+#endif
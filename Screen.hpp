@@ -3,6 +3,8 @@
 
 #include "ConsoleSetup.hpp"
 #include "Styles.hpp"
+#include "Renderer.hpp"
+#include "Recorder.hpp"
 #include <sstream>
 #include <string>
 #include <vector>
@@ -11,26 +13,39 @@
 // --- Application Logic ---
 struct Screen {
     size_t width, height;
-    std::vector<std::vector<std::string>> buffer;
+    CellBuffer buffer;
+    DiffRenderer renderer;
+    SessionRecorder* recorder = nullptr; // Optional, logs every rendered frame
 
     Screen() {
+        renderer.encoder.caps = probeTerminalCapabilities();
         updateSize();
     }
 
+    // Fixed-size screen that never touches the terminal (benchmarks, replays)
+    Screen(size_t w, size_t h) {
+        resize(w, h);
+    }
+
     void updateSize() {
-        
-        #ifdef _WIN32
-            std::system("cls"); // Clear screen before writing (optional, can be removed for better performance)
-        #else
-            std::system("clear"); // Clear screen before writing (optional, can be removed for better performance)
-        #endif
-
-        getWindowSize(width, height);
+        size_t w, h;
+        getWindowSize(w, h);
+        resize(w, h);
+    }
+
+    // Reshapes the buffer in place (rows keep their capacity) and schedules a
+    // full repaint, so a resize never needs to clear the terminal separately.
+    void resize(size_t w, size_t h) {
         // Ensure strictly positive dimensions
-        if (width <= 0) width = 80;
-        if (height <= 0) height = 24;
-        
-        buffer.assign(height, std::vector<std::string>(width, " "));
+        width = w > 0 ? w : 80;
+        height = h > 0 ? h : 24;
+
+        buffer.resize(height);
+        for (std::vector<std::string>& row : buffer) {
+            row.resize(width);
+            std::fill(row.begin(), row.end(), " ");
+        }
+        renderer.invalidate();
     }
 
     void putChar(int x, int y, char c) {
@@ -44,7 +59,7 @@ struct Screen {
     }
 
     // Overload putChar to accept a string (for UTF-8 characters)
-    void putChar(int x, int y, std::string s) {
+    void putChar(int x, int y, const std::string& s) {
         // convert 1-coords to 0-coords
         int vX = x - 1;
         int vY = y - 1;
@@ -99,16 +114,9 @@ struct Screen {
     }
 
     void render() {
-        std::stringstream ss;
-        ss << "\033[H"; 
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                ss << buffer[y][x];
-            }
-            if (y < height - 1) ss << "\r\n";
-        }
-        std::string frame = ss.str();
-        writeBuffer(frame);
+        if (recorder) recorder->recordFrame(buffer);
+        std::string out = renderer.render(buffer);
+        if (!out.empty()) writeBuffer(out);
     }
 };
 
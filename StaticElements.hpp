@@ -0,0 +1,202 @@
+#ifndef STATIC_ELEMENTS_HPP
+#define STATIC_ELEMENTS_HPP
+
+#include "Elements.hpp"
+#include <tuple>
+#include <utility>
+
+// --- Compile-time element trees ---
+// Same layout rules and drawing as the runtime Element tree, but the tree shape is a
+// type: children live by value in a std::tuple, dispatch is static and nothing is
+// allocated. Use it for fixed layouts that never change at runtime.
+//
+//     auto ui = static_ui::terminal(screen,
+//         static_ui::column<static_ui::FillMaxSize>(
+//             static_ui::canvas<static_ui::Fixed<10, 5>>(),
+//             static_ui::row<static_ui::FillMaxWidth<5>>()
+//         )
+//     );
+//     ui.update();
+namespace static_ui {
+
+    // --- Sizing policies (what size(), fillMaxWidth() ... do on the runtime tree) ---
+    template <size_t W, size_t H>
+    struct Fixed {
+        static constexpr pair size = {W, H};
+        static constexpr bool fillWidth = false;
+        static constexpr bool fillHeight = false;
+    };
+
+    template <size_t H>
+    struct FillMaxWidth {
+        static constexpr pair size = {0, H};
+        static constexpr bool fillWidth = true;
+        static constexpr bool fillHeight = false;
+    };
+
+    template <size_t W>
+    struct FillMaxHeight {
+        static constexpr pair size = {W, 0};
+        static constexpr bool fillWidth = false;
+        static constexpr bool fillHeight = true;
+    };
+
+    struct FillMaxSize {
+        static constexpr pair size = {0, 0};
+        static constexpr bool fillWidth = true;
+        static constexpr bool fillHeight = true;
+    };
+
+    // Element::updateActualSize()
+    template <typename Sizing>
+    constexpr pair actualSize(pair constrain) {
+        return {
+            Sizing::fillWidth ? constrain.x : std::min(Sizing::size.x, constrain.x),
+            Sizing::fillHeight ? constrain.y : std::min(Sizing::size.y, constrain.y)
+        };
+    }
+
+    // --- Kinds: arrangement and graphics of each runtime element ---
+    struct ColumnKind {
+        static constexpr Arrangement arrangement = Arrangement::VERTICAL;
+        static void draw(Screen& screen, pair offset, pair actual) {
+            screen.putBox(offset.x, offset.y, Box(actual.x, actual.y, "Column"));
+        }
+    };
+
+    struct RowKind {
+        static constexpr Arrangement arrangement = Arrangement::HORIZONTAL;
+        static void draw(Screen& screen, pair offset, pair actual) {
+            screen.putBox(offset.x, offset.y, Box(actual.x, actual.y, "Row"));
+        }
+    };
+
+    struct CanvasKind {
+        static constexpr Arrangement arrangement = Arrangement::NONE;
+        static void draw(Screen& screen, pair offset, pair actual) {
+            screen.putBox(offset.x, offset.y, Box(actual.x, actual.y, "Canvas"));
+        }
+    };
+
+    struct SpacerKind {
+        static constexpr Arrangement arrangement = Arrangement::NONE;
+        static void draw(Screen&, pair, pair) {}
+    };
+
+    // Advances the arrangement cursor like a Row/Column without weights, gaps or wrapping
+    template <Arrangement A>
+    constexpr pair advance(pair current, pair childSize) {
+        current += childSize;
+        if (A == Arrangement::HORIZONTAL) current.y = 0;
+        else if (A == Arrangement::VERTICAL) current.x = 0;
+        else current = {0, 0};
+        return current;
+    }
+
+    // Lays out and draws one child; returns false once the parent is out of space
+    template <Arrangement A, typename Child>
+    bool updateChild(Child& child, Screen& screen, pair parentOffset, pair parentActual, pair& current) {
+        pair offset = parentOffset + current + pair{1, 1}; // +1 for the border of the parent box
+        if (offset >= parentOffset + parentActual) return false;
+        pair constrain = parentActual + parentOffset - offset - pair{1, 1};
+        current = advance<A>(current, child.update(screen, offset, constrain));
+        return true;
+    }
+
+    template <typename Kind, typename Sizing, typename... Children>
+    struct Node {
+        std::tuple<Children...> children;
+
+        constexpr explicit Node(Children... c) : children(std::move(c)...) {}
+
+        // Size this node takes for a given constraint; usable in constant expressions
+        static constexpr pair measure(pair constrain) {
+            return actualSize<Sizing>(constrain);
+        }
+
+        pair update(Screen& screen, pair offset, pair constrain) {
+            pair actual = measure(constrain);
+            Kind::draw(screen, offset, actual);
+            updateChildren(screen, offset, actual, std::index_sequence_for<Children...>{});
+            return actual;
+        }
+
+    private:
+        template <size_t... I>
+        void updateChildren([[maybe_unused]] Screen& screen, [[maybe_unused]] pair offset, [[maybe_unused]] pair actual, std::index_sequence<I...>) {
+            [[maybe_unused]] pair current = {0, 0}; // leaf nodes have no children to place
+            (void)(updateChild<Kind::arrangement>(std::get<I>(children), screen, offset, actual, current) && ...);
+        }
+    };
+
+    template <typename Sizing>
+    struct Text {
+        std::string m_text;
+
+        explicit Text(std::string text) : m_text(std::move(text)) {}
+
+        static constexpr pair measure(pair constrain) {
+            return actualSize<Sizing>(constrain);
+        }
+
+        pair update(Screen& screen, pair offset, pair constrain) {
+            drawWrappedText(&screen, offset, constrain, m_text);
+            return measure(constrain);
+        }
+    };
+
+    // Root node, equivalent to the runtime Terminal
+    template <typename... Children>
+    struct Terminal {
+        Screen* m_screen;
+        std::tuple<Children...> children;
+
+        Terminal(Screen& s, Children... c)
+            : m_screen(&s), children(std::move(c)...) {}
+
+        void update() {
+            pair actual = {m_screen->width, m_screen->height};
+            updateChildren(actual, std::index_sequence_for<Children...>{});
+        }
+
+    private:
+        template <size_t... I>
+        void updateChildren([[maybe_unused]] pair actual, std::index_sequence<I...>) {
+            [[maybe_unused]] pair current = {0, 0};
+            (void)(updateChild<Arrangement::NONE>(std::get<I>(children), *m_screen, pair{0, 0}, actual, current) && ...);
+        }
+    };
+
+    // --- Factories (mirror drawColumn() & co. in main.cpp) ---
+    template <typename Sizing = Fixed<0, 0>, typename... Children>
+    constexpr Node<ColumnKind, Sizing, Children...> column(Children... c) {
+        return Node<ColumnKind, Sizing, Children...>(std::move(c)...);
+    }
+
+    template <typename Sizing = Fixed<0, 0>, typename... Children>
+    constexpr Node<RowKind, Sizing, Children...> row(Children... c) {
+        return Node<RowKind, Sizing, Children...>(std::move(c)...);
+    }
+
+    template <typename Sizing = Fixed<0, 0>, typename... Children>
+    constexpr Node<CanvasKind, Sizing, Children...> canvas(Children... c) {
+        return Node<CanvasKind, Sizing, Children...>(std::move(c)...);
+    }
+
+    template <typename Sizing>
+    constexpr Node<SpacerKind, Sizing> spacer() {
+        return Node<SpacerKind, Sizing>();
+    }
+
+    template <typename Sizing>
+    Text<Sizing> text(std::string s) {
+        return Text<Sizing>(std::move(s));
+    }
+
+    template <typename... Children>
+    Terminal<Children...> terminal(Screen& screen, Children... c) {
+        return Terminal<Children...>(screen, std::move(c)...);
+    }
+}
+
+#endif
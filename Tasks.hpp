@@ -0,0 +1,184 @@
+#ifndef TASKS_HPP
+#define TASKS_HPP
+
+// Requires C++20 (-std=c++20)
+#include "UpdateQueue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// --- Coroutine tasks on the UI thread ---
+// A Task starts immediately and runs on the UI thread; whenever it co_awaits a timer,
+// input or background work, the main loop keeps going and the task resumes from
+// Scheduler::tick() once the thing it waited for is ready.
+//
+//     Task blink(Scheduler& s, Text* label) {
+//         while (true) {
+//             co_await s.sleep(500);
+//             label->m_text = co_await s.background([] { return fetchStatus(); });
+//         }
+//     }
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; } // frame frees itself
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+struct Scheduler {
+    using Clock = std::chrono::steady_clock;
+
+    struct Timer {
+        Clock::time_point deadline;
+        std::coroutine_handle<> handle;
+        bool operator> (const Timer& other) const { return deadline > other.deadline; }
+    };
+
+    static constexpr unsigned MAX_WORKERS = 4;
+
+    UpdateQueue& m_queue;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> m_timers;
+    std::vector<std::pair<std::coroutine_handle<>, std::string*>> m_inputWaiters;
+
+    // Worker pool for background(), started on first use
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_jobs;
+    std::mutex m_jobsMutex;
+    std::condition_variable m_jobsReady;
+    bool m_stopping = false;
+
+    explicit Scheduler(UpdateQueue& queue) : m_queue(queue) {}
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    // Lets running jobs finish and joins the workers; jobs not started yet are dropped,
+    // and tasks waiting on them are never resumed
+    ~Scheduler() {
+        {
+            std::lock_guard<std::mutex> lock(m_jobsMutex);
+            m_stopping = true;
+            m_jobs.clear();
+        }
+        m_jobsReady.notify_all();
+        for (std::thread& worker : m_workers) worker.join();
+    }
+
+    // Call once per frame from the main loop, before layout
+    void tick() {
+        m_queue.drain();
+        auto now = Clock::now();
+        while (!m_timers.empty() && m_timers.top().deadline <= now) {
+            std::coroutine_handle<> h = m_timers.top().handle;
+            m_timers.pop();
+            h.resume();
+        }
+    }
+
+    // Call with every chunk of input read by the main loop
+    void feedInput(const char* buf, int n) {
+        if (n <= 0 || m_inputWaiters.empty()) return;
+        std::vector<std::pair<std::coroutine_handle<>, std::string*>> waiters;
+        waiters.swap(m_inputWaiters); // resumed tasks may wait again
+        for (auto& [handle, out] : waiters) {
+            out->assign(buf, n);
+            handle.resume();
+        }
+    }
+
+    // co_await sleep(ms): resumes on the first tick after `ms` milliseconds
+    auto sleep(int ms) {
+        struct Awaiter {
+            Scheduler& s;
+            Clock::time_point deadline;
+            bool await_ready() const { return deadline <= Clock::now(); }
+            void await_suspend(std::coroutine_handle<> h) { s.m_timers.push({deadline, h}); }
+            void await_resume() const {}
+        };
+        return Awaiter{*this, Clock::now() + std::chrono::milliseconds(ms)};
+    }
+
+    // co_await nextInput(): the next chunk of raw input bytes
+    auto nextInput() {
+        struct Awaiter {
+            Scheduler& s;
+            std::string input;
+            bool await_ready() const { return false; }
+            void await_suspend(std::coroutine_handle<> h) { s.m_inputWaiters.push_back({h, &input}); }
+            std::string await_resume() { return std::move(input); }
+        };
+        return Awaiter{*this, {}};
+    }
+
+    // co_await background(fn): runs fn on a pool thread, resumes on the UI thread with its result
+    template <typename F>
+    auto background(F fn) {
+        using R = std::invoke_result_t<F>;
+        static_assert(!std::is_void_v<R>, "background() work must return a value");
+
+        struct Awaiter {
+            Scheduler& scheduler;
+            F fn;
+            std::optional<R> result;
+            bool await_ready() const { return false; }
+            void await_suspend(std::coroutine_handle<> h) {
+                scheduler.runOnWorker([this, h] {
+                    result.emplace(fn());
+                    scheduler.m_queue.post([h] { h.resume(); });
+                });
+            }
+            R await_resume() { return std::move(*result); }
+        };
+        return Awaiter{*this, std::move(fn), std::nullopt};
+    }
+
+private:
+    void runOnWorker(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(m_jobsMutex);
+            m_jobs.push_back(std::move(job));
+        }
+        if (m_workers.empty()) {
+            unsigned count = std::clamp(std::thread::hardware_concurrency(), 1u, MAX_WORKERS);
+            for (unsigned i = 0; i < count; i++) m_workers.emplace_back([this] { workerLoop(); });
+        }
+        m_jobsReady.notify_one();
+    }
+
+    void workerLoop() {
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(m_jobsMutex);
+                m_jobsReady.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+                if (m_stopping) return;
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            job();
+        }
+    }
+};
+
+// Scheduler over uiUpdates(); the main loop ticks it and feeds it input when built as C++20.
+// Created after the queue, so at exit it is destroyed (and its workers joined) first.
+inline Scheduler& uiScheduler() {
+    static Scheduler scheduler(uiUpdates());
+    return scheduler;
+}
+
+#endif
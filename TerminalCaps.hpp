@@ -0,0 +1,166 @@
+#ifndef TERMINAL_CAPS_HPP
+#define TERMINAL_CAPS_HPP
+
+#include "ConsoleSetup.hpp"
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#ifndef _WIN32
+    #include <poll.h>
+#endif
+
+// --- Features the attached terminal understands ---
+struct TerminalCaps {
+    bool syncOutput = false;     // DEC private mode 2026 (synchronized update)
+    bool trueColor = false;      // 24-bit SGR colors
+    bool kittyKeyboard = false;  // kitty progressive keyboard protocol
+    bool rep = false;            // CSI Ps b (repeat preceding graphic character)
+    bool ech = false;            // CSI Ps X (erase characters)
+    bool scrollRegion = false;   // DECSTBM + SU/SD
+    int daLevel = 0;             // First parameter of the DA1 reply (62 = VT220, 64 = VT420, ...)
+};
+
+// Parses the replies collected by probeTerminalCapabilities().
+// Returns true once the DA1 reply (the last query sent) has been seen.
+bool parseCapabilityReplies(const std::string& replies, TerminalCaps& caps) {
+    bool sawDA = false;
+
+    size_t i = 0;
+    while ((i = replies.find('\033', i)) != std::string::npos) {
+        if (i + 1 >= replies.size()) break;
+        char intro = replies[i + 1];
+
+        // DCS reply to DECRQSS: ESC P 1 $ r <params> ST
+        if (intro == 'P') {
+            size_t end = replies.find("\033\\", i + 2);
+            if (end == std::string::npos) break;
+            std::string body = replies.substr(i + 2, end - i - 2);
+            if (body.rfind("1$r", 0) == 0 && body.find("1:2:3") != std::string::npos) {
+                caps.trueColor = true;
+            }
+            i = end + 2;
+            continue;
+        }
+
+        if (intro != '[' || i + 2 >= replies.size()) {
+            i++;
+            continue;
+        }
+
+        // CPR after the REP test: ESC [ <row> ; <col> R. The test starts in column 1 and
+        // prints "x" repeated twice more, so a terminal that implements REP is in column 4.
+        if (replies[i + 2] != '?') {
+            size_t p = i + 2;
+            while (p < replies.size() && (std::isdigit((unsigned char)replies[p]) || replies[p] == ';')) p++;
+            if (p >= replies.size()) break;
+            if (replies[p] == 'R') {
+                size_t semi = replies.find(';', i + 2);
+                if (semi != std::string::npos && semi < p) caps.rep = std::atoi(replies.c_str() + semi + 1) == 4;
+            }
+            i = p + 1;
+            continue;
+        }
+
+        // CSI ? <params> [intermediates] <final>
+        size_t p = i + 3;
+        std::string params, intermediates;
+        while (p < replies.size() && (std::isdigit((unsigned char)replies[p]) || replies[p] == ';')) params += replies[p++];
+        while (p < replies.size() && replies[p] >= 0x20 && replies[p] <= 0x2F) intermediates += replies[p++];
+        if (p >= replies.size()) break;
+        char final = replies[p];
+
+        if (final == 'c') {
+            caps.daLevel = std::atoi(params.c_str());
+            sawDA = true;
+        } else if (final == 'u') {
+            caps.kittyKeyboard = true;
+        } else if (final == 'y' && intermediates == "$") {
+            // DECRPM: <mode>;<state>, state 1/2 = set/reset, 3 = permanently set
+            size_t semi = params.find(';');
+            if (semi != std::string::npos && params.substr(0, semi) == "2026") {
+                int state = std::atoi(params.c_str() + semi + 1);
+                caps.syncOutput = (state == 1 || state == 2 || state == 3);
+            }
+        }
+        i = p + 1;
+    }
+
+    if (sawDA) {
+        caps.scrollRegion = caps.daLevel >= 1;
+        caps.ech = caps.daLevel >= 62;
+    }
+    return sawDA;
+}
+
+// Asks the terminal what it supports. Must be called after enableRawMode().
+// DA1 is sent last, so every terminal answers at least that. A slow or remote
+// terminal may answer after `timeoutMs`: the features are then decided from what
+// arrived in time, and the late replies are drained (up to the DA1 reply, or until
+// stdin stays quiet for `graceMs`) so they never reach readInput() as key presses.
+TerminalCaps probeTerminalCapabilities(int timeoutMs = 150, int graceMs = 50) {
+    TerminalCaps caps;
+
+    const char* colorterm = std::getenv("COLORTERM");
+    if (colorterm) {
+        std::string ct = colorterm;
+        caps.trueColor = (ct == "truecolor" || ct == "24bit");
+    }
+
+    #ifdef _WIN32
+        // Windows Terminal / conhost with VT processing handle all of these
+        if (std::getenv("WT_SESSION")) {
+            caps.trueColor = true;
+            caps.ech = true;
+            caps.rep = true;
+            caps.scrollRegion = true;
+        }
+        (void)timeoutMs;
+        (void)graceMs;
+        return caps;
+    #else
+        if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO)) return caps;
+
+        writeBuffer(
+            "\033[?2026$p"                            // DECRQM synchronized output
+            "\033[?u"                                 // kitty keyboard flags
+            "\033[48:2:1:2:3m\033P$qm\033\\\033[m"    // DECRQSS of a truecolor SGR
+            "\rx\033[2b\033[6n\r\033[2K"              // REP test: print "x" + 2 repeats, report the cursor, erase
+            "\033[c"                                  // DA1 (sentinel)
+        );
+
+        std::string replies;
+        char buf[256];
+
+        // Appends whatever arrives within `ms`; false on timeout or a read error
+        auto readWithin = [&](long ms) {
+            struct pollfd pfd = {STDIN_FILENO, POLLIN, 0};
+            if (ms <= 0 || poll(&pfd, 1, (int)ms) <= 0) return false;
+            int n = read(STDIN_FILENO, buf, sizeof(buf));
+            if (n <= 0) return false;
+            replies.append(buf, n);
+            return true;
+        };
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (true) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if (!readWithin(remaining)) break;
+
+            TerminalCaps parsed = caps;
+            if (parseCapabilityReplies(replies, parsed)) {
+                return parsed;
+            }
+        }
+
+        parseCapabilityReplies(replies, caps);
+
+        // Timed out: swallow late replies so stray CSI ? ... c/y/u bytes aren't read as input
+        TerminalCaps late;
+        while (!parseCapabilityReplies(replies, late) && readWithin(graceMs)) {}
+        return caps;
+    #endif
+}
+
+#endif
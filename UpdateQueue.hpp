@@ -0,0 +1,93 @@
+#ifndef UPDATE_QUEUE_HPP
+#define UPDATE_QUEUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+// --- Multi-producer / single-consumer queue of UI mutations ---
+// Any thread may post() a callback; the UI thread runs them with drain() once per
+// frame, before layout, so elements are only ever touched from the UI thread.
+// Intrusive Vyukov queue: post() is one atomic exchange, drain() takes no locks.
+struct UpdateQueue {
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        std::function<void()> fn;
+    };
+
+    alignas(64) std::atomic<Node*> m_head; // last node pushed (producers)
+    alignas(64) Node* m_tail;              // next node to run (consumer)
+    Node m_stub;
+
+    UpdateQueue() : m_head(&m_stub), m_tail(&m_stub) {}
+
+    UpdateQueue(const UpdateQueue&) = delete;
+    UpdateQueue& operator=(const UpdateQueue&) = delete;
+
+    ~UpdateQueue() {
+        while (Node* n = pop()) delete n;
+    }
+
+    // Thread-safe, wait-free for producers
+    void post(std::function<void()> fn) {
+        Node* n = new Node;
+        n->fn = std::move(fn);
+        push(n);
+    }
+
+    // Runs every callback posted so far (up to `max`); UI thread only. Returns how many ran.
+    size_t drain(size_t max = SIZE_MAX) {
+        size_t ran = 0;
+        while (ran < max) {
+            Node* n = pop();
+            if (!n) break;
+            n->fn();
+            delete n;
+            ran++;
+        }
+        return ran;
+    }
+
+private:
+    void push(Node* n) {
+        n->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = m_head.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+
+    // Returns nullptr when empty, or when a producer is between its exchange and its link
+    // (that node is picked up by the next drain)
+    Node* pop() {
+        Node* tail = m_tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+
+        if (tail == &m_stub) {
+            if (!next) return nullptr;
+            m_tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            m_tail = next;
+            return tail;
+        }
+
+        if (tail != m_head.load(std::memory_order_acquire)) return nullptr;
+
+        push(&m_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            m_tail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+};
+
+// The queue the main loop drains every frame; post() to it from any thread
+inline UpdateQueue& uiUpdates() {
+    static UpdateQueue queue;
+    return queue;
+}
+
+#endif
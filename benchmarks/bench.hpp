@@ -0,0 +1,15 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <chrono>
+
+// Runs f `iterations` times and returns the mean wall time of one call in microseconds
+template <typename F>
+double timeUs(F&& f, int iterations = 1) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+#endif
@@ -0,0 +1,48 @@
+// Measures plotting a point cloud into a pixel Canvas, batched vs. one point() at a time.
+// Build: g++ -std=c++17 -O2 -o canvas_points benchmarks/canvas_points.cpp
+#include "../Elements.hpp"
+#include "bench.hpp"
+#include <cstdio>
+#include <random>
+
+const size_t CELLS_X = 200, CELLS_Y = 60;
+const size_t POINTS = 100000;
+const int STEPS = 200;
+
+int main() {
+    Screen screen(CELLS_X + 4, CELLS_Y + 4); // terminal and canvas borders take a cell per side
+    Canvas* canvas = new Canvas(0, 0);
+    canvas->fillMaxSize();
+    canvas->pixelMode(PixelMode::BRAILLE);
+    Terminal terminal(&screen, {canvas});
+    terminal.update();
+
+    Bitmap& bitmap = canvas->pixels();
+    std::printf("bitmap: %zux%zu cells, %zux%zu dots\n", bitmap.cellWidth, bitmap.cellHeight,
+                bitmap.pixelWidth(), bitmap.pixelHeight());
+
+    // A few points fall outside so clipping is part of the measurement
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> xDist(-8, (int)bitmap.pixelWidth() + 8);
+    std::uniform_int_distribution<int> yDist(-8, (int)bitmap.pixelHeight() + 8);
+    std::vector<int> xs(POINTS), ys(POINTS);
+    for (size_t i = 0; i < POINTS; i++) { xs[i] = xDist(rng); ys[i] = yDist(rng); }
+
+    double single = 0, batched = 0, frame = 0;
+    for (int step = 0; step < STEPS; step++) {
+        bitmap.clear();
+        single += timeUs([&] { for (size_t i = 0; i < POINTS; i++) bitmap.point(xs[i], ys[i]); });
+        std::vector<uint8_t> expected = bitmap.cells;
+
+        bitmap.clear();
+        batched += timeUs([&] { bitmap.points(xs.data(), ys.data(), POINTS); });
+        if (bitmap.cells != expected) { std::printf("batched result differs\n"); return 1; }
+
+        frame += timeUs([&] { terminal.update(); });
+    }
+
+    std::printf("point() loop:    %8.1f us per %zu points\n", single / STEPS, POINTS);
+    std::printf("points() batch:  %8.1f us per %zu points\n", batched / STEPS, POINTS);
+    std::printf("canvas to cells: %8.1f us per frame\n", frame / STEPS);
+    return 0;
+}
@@ -0,0 +1,45 @@
+// Measures full vs. incremental layout of a large runtime Element tree.
+// Build: g++ -std=c++17 -O2 -o layout_cache benchmarks/layout_cache.cpp
+#include "../Elements.hpp"
+#include "bench.hpp"
+#include <cstdio>
+
+const size_t ROWS = 500, LEAVES_PER_ROW = 100; // 50k leaves
+
+int main() {
+    Screen screen(1000, 1000);
+    Terminal terminal(&screen);
+
+    Column* column = new Column(0, 0);
+    column->fillMaxSize()->gap(1);
+    terminal.addChild(column);
+
+    std::vector<Element*> leaves;
+    for (size_t r = 0; r < ROWS; r++) {
+        Row* row = new Row(0, 0);
+        row->fillMaxWidth()->height(3)->gap(1)->align(Alignment::CENTER);
+        column->addChild(row);
+        for (size_t l = 0; l < LEAVES_PER_ROW; l++) {
+            Element* leaf = (l % 10 == 0) ? (new Spacer(0, 1))->weight(1) : new Spacer(2, 1);
+            row->addChild(leaf);
+            leaves.push_back(leaf);
+        }
+    }
+
+    double full = timeUs([&] { terminal.updateLayout(); });
+    double clean = timeUs([&] { terminal.updateLayout(); });
+
+    const int STEPS = 1000;
+    double leafTotal = 0;
+    for (int i = 0; i < STEPS; i++) {
+        Element* leaf = leaves[(i * 7919) % leaves.size()];
+        leaf->width(2 + i % 3);
+        leafTotal += timeUs([&] { terminal.updateLayout(); });
+    }
+
+    std::printf("nodes: %zu\n", ROWS * (LEAVES_PER_ROW + 1) + 2);
+    std::printf("full layout:        %10.1f us\n", full);
+    std::printf("clean relayout:     %10.1f us\n", clean);
+    std::printf("leaf change relayout: %8.1f us (avg of %d)\n", leafTotal / STEPS, STEPS);
+    return 0;
+}
@@ -0,0 +1,64 @@
+// Compares the runtime Element tree against the same layout built with static_ui.
+// Build: g++ -std=c++17 -O2 -o static_vs_runtime benchmarks/static_vs_runtime.cpp
+#include "../Elements.hpp"
+#include "../StaticElements.hpp"
+#include "bench.hpp"
+#include <cstdio>
+
+namespace su = static_ui;
+
+const size_t WIDTH = 200, HEIGHT = 60;
+const int ITERATIONS = 20000;
+
+Element* runtimePanel() {
+    return (new Column(0, 0, {
+        (new Canvas(12, 6))->fillMaxWidth(),
+        (new Row(0, 0, {
+            new Canvas(10, 5),
+            new Canvas(10, 5),
+            new Text(20, 3, "cpu 42% mem 13%")
+        }))->fillMaxWidth()->height(7),
+        new Spacer(1, 1),
+        (new Canvas(0, 0))->fillMaxSize()
+    }))->width(48)->fillMaxHeight();
+}
+
+auto staticPanel() {
+    return su::column<su::FillMaxHeight<48>>(
+        su::canvas<su::FillMaxWidth<6>>(),
+        su::row<su::FillMaxWidth<7>>(
+            su::canvas<su::Fixed<10, 5>>(),
+            su::canvas<su::Fixed<10, 5>>(),
+            su::text<su::Fixed<20, 3>>("cpu 42% mem 13%")
+        ),
+        su::spacer<su::Fixed<1, 1>>(),
+        su::canvas<su::FillMaxSize>()
+    );
+}
+
+// Sizes known at compile time fold to constants
+static_assert(decltype(staticPanel())::measure({80, 24}) == pair{48, 24}, "static measure");
+
+int main() {
+    Screen runtimeScreen(WIDTH, HEIGHT), staticScreen(WIDTH, HEIGHT);
+
+    Terminal runtimeTree(&runtimeScreen, {
+        (new Row(0, 0, { runtimePanel(), runtimePanel(), runtimePanel(), runtimePanel() }))->fillMaxSize()
+    });
+    auto staticTree = su::terminal(staticScreen,
+        su::row<su::FillMaxSize>(staticPanel(), staticPanel(), staticPanel(), staticPanel())
+    );
+
+    runtimeTree.update();
+    staticTree.update();
+    bool same = runtimeScreen.buffer == staticScreen.buffer;
+
+    double runtimeUs = timeUs([&] { runtimeTree.update(); }, ITERATIONS);
+    double staticUs = timeUs([&] { staticTree.update(); }, ITERATIONS);
+
+    std::printf("identical output: %s\n", same ? "yes" : "NO");
+    std::printf("runtime tree: %8.2f us/update\n", runtimeUs);
+    std::printf("static tree:  %8.2f us/update\n", staticUs);
+    std::printf("sizeof(static tree): %zu bytes, no heap\n", sizeof(staticTree));
+    return same ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+// Throughput of UpdateQueue with many producer threads and one draining UI thread.
+// Build: g++ -std=c++17 -O2 -pthread -o update_queue benchmarks/update_queue.cpp
+#include "../UpdateQueue.hpp"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+const size_t POSTS_PER_PRODUCER = 200000;
+
+int main() {
+    for (size_t producers : {1, 2, 4, 8, 16, 32}) {
+        UpdateQueue queue;
+        size_t counter = 0; // only touched by drained callbacks, i.e. the consumer
+        size_t expected = producers * POSTS_PER_PRODUCER;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < producers; p++) {
+            threads.emplace_back([&queue, &counter] {
+                for (size_t i = 0; i < POSTS_PER_PRODUCER; i++) {
+                    queue.post([&counter] { counter++; });
+                }
+            });
+        }
+
+        size_t frames = 0;
+        while (counter < expected) {
+            queue.drain();
+            frames++;
+        }
+        for (std::thread& t : threads) t.join();
+        auto end = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        std::printf("%2zu producers: %6.2f M updates/s (%zu drains)\n", producers, expected / seconds / 1e6, frames);
+    }
+    return 0;
+}
@@ -1,53 +1,38 @@
 #include "main.hpp"
 
-Column* drawColumn(std::initializer_list<Element*> list = {}) {
-    return new Column(0, 0, list);
-}
-
-Row* drawRow(std::initializer_list<Element*> list = {}) {
-    return new Row(0, 0, list);
-}
-
-Canvas* drawCanvas(std::initializer_list<Element*> list = {}) {
-    return new Canvas(0, 0, list);
-}
-
-
 int main() {
     enableRawMode();
     Screen screen = Screen();
 
-    Terminal terminal(&screen, {
-        drawColumn({
-            drawColumn({
-                drawCanvas()->size(10, 5),
-                drawCanvas()->size(10, 5),
-                drawRow()->fillMaxWidth()->height(5)
-            })->fillMaxSize()
-        })->fillMaxSize()
-    });
+    Terminal& terminal = *buildApp(&screen);
+
+    // Set TUI_RECORD=<file> to record the session for tools/replay
+    SessionRecorder recorder;
+    if (const char* path = std::getenv("TUI_RECORD")) {
+        if (recorder.open(path)) screen.recorder = &recorder;
+    }
 
 
+    // Worker threads post() element changes to uiUpdates(); appTick() runs them (and, with
+    // C++20, resumes coroutine Tasks) and appInput() hands input to the app
     char buf[1024];
 
     while (true) {
 
-        size_t deltaW, deltaH;
-        getWindowSize(deltaW, deltaH);
-        if (deltaW != screen.width || deltaH != screen.height) {
-            screen.updateSize();
+        size_t newW, newH;
+        if (pollResize(newW, newH)) {
+            screen.resize(newW, newH);
         }
 
+        appTick();
         terminal.update();
 
         // READ INPUT
         int nread = readInput(buf, sizeof(buf));
         
         if (nread > 0) {
-            // Quit on 'q'
-            for(int i=0; i<nread; i++) {
-                if (buf[i] == 'q') exit(0);
-            }
+            recorder.recordInput(buf, nread);
+            if (!appInput(buf, nread)) break; // returning (not exit()) flushes the recording
         }
         screen.render();
         sleepMs(33); // Sleep 10ms (approx 100 FPS cap)
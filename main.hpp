@@ -10,6 +10,8 @@
 #include <cstdlib>
 #include "Screen.hpp"
 #include "Elements.hpp"
+#include "App.hpp"
+#include "UpdateQueue.hpp"
 
 // --- Platform Specific Includes and Definitions ---
 
@@ -0,0 +1,58 @@
+// Attaches the current terminal to a SessionServer listening on a Unix socket.
+// Usage: attach <socket path>      (press Ctrl-] to detach)
+// Build: g++ -std=c++17 -O2 -o attach tools/attach.cpp
+#include "../ConsoleSetup.hpp"
+#include <cstdio>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+void sendSize(int sock) {
+    size_t width, height;
+    getWindowSize(width, height);
+    std::string report = "\033[8;" + std::to_string(height) + ";" + std::to_string(width) + "t";
+    (void)!write(sock, report.data(), report.size());
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <socket path>\n", argv[0]);
+        return 2;
+    }
+
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", argv[1]);
+    if (sock < 0 || connect(sock, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        std::perror("connect");
+        return 1;
+    }
+
+    enableRawMode();
+    std::cout << "\033[2J" << std::flush;
+    sendSize(sock);
+
+    char buf[4096];
+    while (true) {
+        size_t w, h;
+        if (pollResize(w, h, 0)) sendSize(sock);
+
+        pollfd fds[2] = {{STDIN_FILENO, POLLIN, 0}, {sock, POLLIN, 0}};
+        if (poll(fds, 2, 50) < 0) continue; // interrupted by SIGWINCH
+
+        if (fds[0].revents & POLLIN) {
+            int n = readInput(buf, sizeof(buf));
+            for (int i = 0; i < n; i++) {
+                if (buf[i] == 0x1d) return 0; // Ctrl-]
+            }
+            if (n > 0) (void)!write(sock, buf, n);
+        }
+        if (fds[1].revents & (POLLIN | POLLHUP)) {
+            ssize_t n = read(sock, buf, sizeof(buf));
+            if (n <= 0) return 0;
+            writeBuffer(std::string(buf, n));
+        }
+    }
+}
@@ -0,0 +1,111 @@
+// Replays a session recorded with TUI_RECORD=<file>.
+//
+//   replay <recording>                        re-drive layout/paint headless, print per-frame timings
+//                                             (recorded input goes back in through appInput())
+//   replay <recording> --asciicast <out.cast> also export the recorded frames as asciicast v2
+//
+// Build: g++ -std=c++17 -O2 -o replay tools/replay.cpp
+#include "../App.hpp"
+#include "../Recorder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using Clock = std::chrono::steady_clock;
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (unsigned char c : s) {
+        if (c == '"') out += "\\\"";
+        else if (c == '\\') out += "\\\\";
+        else if (c < 0x20) {
+            char hex[8];
+            std::snprintf(hex, sizeof(hex), "\\u%04x", c);
+            out += hex;
+        } else out += (char)c;
+    }
+    return out;
+}
+
+// asciicast timestamps are seconds with microsecond precision
+std::string castTime(uint64_t us) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.6f", us / 1e6);
+    return buf;
+}
+
+void printStats(const char* name, std::vector<double>& us) {
+    if (us.empty()) return;
+    std::sort(us.begin(), us.end());
+    double sum = 0;
+    for (double v : us) sum += v;
+    std::printf("%-14s mean %8.1f us   p50 %8.1f   p99 %8.1f   max %8.1f\n", name,
+        sum / us.size(), us[us.size() / 2], us[std::min(us.size() - 1, us.size() * 99 / 100)], us.back());
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <recording> [--asciicast <out.cast>]\n", argv[0]);
+        return 2;
+    }
+    const char* castPath = (argc >= 4 && std::strcmp(argv[2], "--asciicast") == 0) ? argv[3] : nullptr;
+
+    SessionReader reader;
+    if (!reader.open(argv[1])) {
+        std::fprintf(stderr, "%s: not a recording\n", argv[1]);
+        return 1;
+    }
+
+    Screen screen(80, 24);           // headless backend, resized by the recording
+    Terminal* app = buildApp(&screen);
+    DiffRenderer castRenderer;       // plain VT100 output for players
+    std::ofstream cast;
+
+    std::vector<double> layoutUs, encodeUs;
+    size_t frames = 0, mismatches = 0, inputs = 0, bytes = 0;
+
+    SessionReader::Record r;
+    while (reader.next(r)) {
+        if (r.type == 'R') {
+            screen.resize(r.width, r.height);
+            if (castPath && !cast.is_open()) {
+                cast.open(castPath, std::ios::binary | std::ios::trunc);
+                cast << "{\"version\": 2, \"width\": " << r.width << ", \"height\": " << r.height << "}\n";
+            } else if (cast.is_open()) {
+                cast << "[" << castTime(r.timeUs) << ", \"r\", \"" << r.width << "x" << r.height << "\"]\n";
+            }
+        } else if (r.type == 'I') {
+            inputs++;
+            if (cast.is_open()) cast << "[" << castTime(r.timeUs) << ", \"i\", \"" << jsonEscape(r.input) << "\"]\n";
+            if (!appInput(r.input.data(), (int)r.input.size())) break; // the app quit here
+        } else if (r.type == 'F') {
+            frames++;
+
+            auto t0 = Clock::now();
+            appTick();
+            app->update();
+            auto t1 = Clock::now();
+            std::string out = screen.renderer.render(screen.buffer);
+            auto t2 = Clock::now();
+
+            layoutUs.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+            encodeUs.push_back(std::chrono::duration<double, std::micro>(t2 - t1).count());
+            bytes += out.size();
+            if (screen.buffer != reader.frame) mismatches++;
+
+            if (cast.is_open()) {
+                std::string data = castRenderer.render(reader.frame);
+                if (!data.empty()) cast << "[" << castTime(r.timeUs) << ", \"o\", \"" << jsonEscape(data) << "\"]\n";
+            }
+        }
+    }
+
+    std::printf("frames: %zu   inputs: %zu   encoded: %zu bytes\n", frames, inputs, bytes);
+    printStats("layout+paint", layoutUs);
+    printStats("encode", encodeUs);
+    if (mismatches) std::printf("warning: %zu frames differ from the recording\n", mismatches);
+    if (cast.is_open()) std::printf("asciicast written to %s\n", castPath);
+    return 0;
+}
@@ -0,0 +1,46 @@
+// Serves the demo app (buildApp) to many terminals at once.
+// Usage: serve <socket path> [/dev/pts/N ...]   (clients attach with tools/attach, 'q' detaches one)
+// Build: g++ -std=c++17 -O2 -o serve tools/serve.cpp
+#include "../App.hpp"
+#include "../MultiClient.hpp"
+#include <csignal>
+#include <cstdio>
+
+volatile sig_atomic_t stopRequested = 0;
+
+void onStop(int) { stopRequested = 1; }
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <socket path> [tty ...]\n", argv[0]);
+        return 2;
+    }
+
+    SessionServer server(buildApp);
+    if (!server.listen(argv[1])) {
+        std::perror("listen");
+        return 1;
+    }
+    for (int i = 2; i < argc; i++) {
+        int fd = open(argv[i], O_RDWR | O_NOCTTY);
+        if (fd < 0) std::perror(argv[i]);
+        else server.addTty(fd);
+    }
+
+    server.onInput = [](ClientSession& client, const std::string& input) {
+        if (input.find('q') != std::string::npos) client.closed = true;
+    };
+
+    // Leave through the destructor so served ttys get their settings back
+    std::signal(SIGINT, onStop);
+    std::signal(SIGTERM, onStop);
+
+    std::printf("serving on %s\n", argv[1]);
+    while (!stopRequested) {
+        server.pump(33);
+        appTick(); // app state changes from other threads, before layout
+        server.renderFrame();
+    }
+    unlink(argv[1]);
+    return 0;
+}